@@ -0,0 +1,115 @@
+#include "BranchOrder.hxx"
+
+const char* BranchOrder::name(int strategy) {
+    switch (strategy) {
+        case DEGREE: return "degree";
+        case CONSTRAINED: return "constrained";
+        case PROBE: return "probe";
+        default: return "input";
+    }
+}
+
+std::vector<int> BranchOrder::order(const std::vector<std::vector<int>>& monomers, int strategy) {
+    std::vector<int> order(monomers.size());
+    std::iota(order.begin(), order.end(), 0);
+    if (strategy != DEGREE && strategy != CONSTRAINED) return order;
+
+    std::vector<double> score(monomers.size(), 0.0);
+    if (strategy == DEGREE) {
+        for (size_t i = 0; i < monomers.size(); i++) {
+            for (int x : monomers[i]) {
+                score[i] += std::abs(x);
+            }
+        }
+    } else {
+        // A site is constraining for a monomer when few other monomers carry
+        // the complementary sign there
+        size_t numSites = monomers.empty() ? 0 : monomers[0].size();
+        std::vector<int> positive(numSites, 0), negative(numSites, 0);
+        for (const auto& monomer : monomers) {
+            for (size_t j = 0; j < numSites; j++) {
+                if (monomer[j] > 0) positive[j]++;
+                if (monomer[j] < 0) negative[j]++;
+            }
+        }
+        for (size_t i = 0; i < monomers.size(); i++) {
+            for (size_t j = 0; j < numSites; j++) {
+                int partners = monomers[i][j] > 0 ? negative[j] : (monomers[i][j] < 0 ? positive[j] : 0);
+                if (monomers[i][j] != 0) {
+                    score[i] += 1.0 / (partners + 1);
+                }
+            }
+        }
+    }
+
+    std::stable_sort(order.begin(), order.end(), [&score](int a, int b) { return score[a] < score[b]; });
+    return order;
+}
+
+std::vector<std::vector<int>> BranchOrder::apply(const std::vector<std::vector<int>>& monomers,
+                                                 const std::vector<int>& order) {
+    std::vector<std::vector<int>> reordered;
+    reordered.reserve(order.size());
+    for (int i : order) {
+        reordered.push_back(monomers[i]);
+    }
+    return reordered;
+}
+
+std::vector<std::vector<int>> BranchOrder::reorder(const std::vector<std::vector<int>>& basis,
+                                                   const std::vector<int>& order) {
+    std::vector<std::vector<int>> reordered;
+    reordered.reserve(basis.size());
+    for (const auto& element : basis) {
+        std::vector<int> searched(element.size(), 0);
+        for (size_t k = 0; k < order.size(); k++) {
+            searched[k] = element[order[k]];
+        }
+        reordered.push_back(searched);
+    }
+    return reordered;
+}
+
+std::vector<std::vector<int>> BranchOrder::restore(const std::vector<std::vector<int>>& basis,
+                                                   const std::vector<int>& order) {
+    std::vector<std::vector<int>> restored;
+    restored.reserve(basis.size());
+    for (const auto& element : basis) {
+        std::vector<int> original(element.size(), 0);
+        for (size_t k = 0; k < order.size(); k++) {
+            original[order[k]] = element[k];
+        }
+        restored.push_back(original);
+    }
+    return restored;
+}
+
+void BranchOrder::printLevelSizes(const std::vector<long>& levelSizes) {
+    long total = std::accumulate(levelSizes.begin(), levelSizes.end(), 0L);
+    std::cout << "Frontier sizes per level:";
+    for (long size : levelSizes) {
+        std::cout << " " << size;
+    }
+    std::cout << " (total " << total << ")" << std::endl;
+}
+
+int BranchOrder::probe(const std::vector<std::vector<int>>& monomers, int probeLevels) {
+    int best = INPUT;
+    long bestTotal = -1;
+    for (int strategy : {INPUT, DEGREE, CONSTRAINED}) {
+        std::vector<std::vector<int>> reordered = apply(monomers, order(monomers, strategy));
+        HilbertBasis hb(reordered);
+        hb.verbose = false;
+        hb.computeFrom(hb.initialLevel(), {}, probeLevels);
+
+        long total = std::accumulate(hb.levelSizes.begin(), hb.levelSizes.end(), 0L);
+        std::cout << "Ordering " << name(strategy) << ": ";
+        printLevelSizes(hb.levelSizes);
+        if (bestTotal == -1 || total < bestTotal) {
+            bestTotal = total;
+            best = strategy;
+        }
+    }
+    std::cout << "Using ordering: " << name(best) << std::endl;
+    return best;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <vector>
+#include "HilbertBasis.hxx"
+
+// Static orderings of the monomer list for the frozen-status search.
+//
+// The search roots every combination at its highest-index monomer and only
+// ever branches downwards from there, so the order of the input file decides
+// the shape of the tree. A strategy returns a permutation (order[k] is the
+// input index of the monomer searched at position k); results are mapped back
+// to the input indexing with restore().
+class BranchOrder {
+public:
+    enum Strategy {
+        INPUT = 0,       // keep the input order
+        DEGREE = 1,      // fewest binding sites first, busiest monomers become roots
+        CONSTRAINED = 2, // monomers on sites with few partners become roots
+        PROBE = -1       // try every strategy for a few levels and keep the narrowest
+    };
+
+    static std::vector<int> order(const std::vector<std::vector<int>>& monomers, int strategy);
+    static std::vector<std::vector<int>> apply(const std::vector<std::vector<int>>& monomers,
+                                               const std::vector<int>& order);
+    // Basis elements from the input indexing to the search indexing, and back
+    static std::vector<std::vector<int>> reorder(const std::vector<std::vector<int>>& basis,
+                                                 const std::vector<int>& order);
+    static std::vector<std::vector<int>> restore(const std::vector<std::vector<int>>& basis,
+                                                 const std::vector<int>& order);
+    // Run probeLevels levels under each strategy, print the frontier sizes and
+    // return the strategy with the fewest nodes
+    static int probe(const std::vector<std::vector<int>>& monomers, int probeLevels);
+    static void printLevelSizes(const std::vector<long>& levelSizes);
+    static const char* name(int strategy);
+};
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+
+// Coefficient vector of a frontier node, stored with the narrowest entry
+// width that holds all of its values: 8 bits, promoted to 16 and then 32 bits
+// the first time a value does not fit. Multiplicities stay small on every
+// level we can reach, so nodes normally take one byte per monomer.
+class CoeffVector {
+public:
+    CoeffVector() {}
+    CoeffVector(const std::vector<int>& values) { assign(values); }
+
+    void assign(const std::vector<int>& values) {
+        width = 1;
+        for (int x : values) {
+            int needed = widthFor(x);
+            if (needed > width) width = needed;
+        }
+        length = values.size();
+        data.assign(length * width, 0);
+        for (size_t i = 0; i < length; i++) {
+            store(i, values[i]);
+        }
+    }
+
+    size_t size() const { return length; }
+    int bytesPerEntry() const { return width; }
+    size_t capacityBytes() const { return data.capacity(); }
+
+    int operator[](size_t i) const {
+        if (width == 1) return (int8_t)data[i];
+        if (width == 2) {
+            int16_t value;
+            std::memcpy(&value, &data[i * 2], 2);
+            return value;
+        }
+        int32_t value;
+        std::memcpy(&value, &data[i * 4], 4);
+        return value;
+    }
+
+    void set(size_t i, int value) {
+        int needed = widthFor(value);
+        if (needed > width) promote(needed);
+        store(i, value);
+    }
+
+    std::vector<int> toVector() const {
+        std::vector<int> values(length);
+        for (size_t i = 0; i < length; i++) {
+            values[i] = (*this)[i];
+        }
+        return values;
+    }
+
+    bool operator==(const CoeffVector& other) const {
+        if (length != other.length) return false;
+        if (width == other.width) return data == other.data;
+        for (size_t i = 0; i < length; i++) {
+            if ((*this)[i] != other[i]) return false;
+        }
+        return true;
+    }
+    bool operator!=(const CoeffVector& other) const { return !(*this == other); }
+
+    // Lexicographic by value, like std::vector<int>
+    bool operator<(const CoeffVector& other) const {
+        size_t common = length < other.length ? length : other.length;
+        for (size_t i = 0; i < common; i++) {
+            int a = (*this)[i], b = other[i];
+            if (a != b) return a < b;
+        }
+        return length < other.length;
+    }
+    bool operator>(const CoeffVector& other) const { return other < *this; }
+
+private:
+    std::vector<unsigned char> data;
+    size_t length = 0;
+    int width = 1;
+
+    static int widthFor(int value) {
+        if (value >= INT8_MIN && value <= INT8_MAX) return 1;
+        if (value >= INT16_MIN && value <= INT16_MAX) return 2;
+        return 4;
+    }
+
+    void store(size_t i, int value) {
+        if (width == 1) {
+            data[i] = (unsigned char)(int8_t)value;
+        } else if (width == 2) {
+            int16_t narrow = value;
+            std::memcpy(&data[i * 2], &narrow, 2);
+        } else {
+            int32_t wide = value;
+            std::memcpy(&data[i * 4], &wide, 4);
+        }
+    }
+
+    void promote(int newWidth) {
+        std::vector<int> values = toVector();
+        width = newWidth;
+        data.assign(length * width, 0);
+        for (size_t i = 0; i < length; i++) {
+            store(i, values[i]);
+        }
+    }
+};
@@ -0,0 +1,165 @@
+#include "CostEstimator.hxx"
+
+#include <chrono>
+#include <cmath>
+#include <random>
+
+// Standard errors of the sample mean on either side of the estimate
+static const double spreadErrors = 2.0;
+
+double CostEstimate::nodesLow() const {
+    return std::max((double)pilotNodes + frontierSize, nodes - spreadErrors * std::sqrt(nodesVariance));
+}
+
+double CostEstimate::nodesHigh() const {
+    return nodes + spreadErrors * std::sqrt(nodesVariance);
+}
+
+double CostEstimate::secondsLow() const {
+    return std::max(pilotSeconds, seconds - spreadErrors * std::sqrt(secondsVariance));
+}
+
+double CostEstimate::secondsHigh() const {
+    return seconds + spreadErrors * std::sqrt(secondsVariance);
+}
+
+typedef std::chrono::steady_clock Clock;
+
+// One random path down from the frontier at the given level. Adds the
+// weighted node count and expansion time of the path to nodes and seconds.
+static void samplePath(const HilbertBasis& hb, const std::vector<FrontierPair>& frontier, int level,
+                       std::vector<std::vector<int>>& basis, std::mt19937& rng, CostEstimate& result,
+                       double& nodes, double& seconds) {
+    FrontierPair node = frontier[std::uniform_int_distribution<size_t>(0, frontier.size() - 1)(rng)];
+    double weight = frontier.size();
+    std::vector<FrontierPair> children;
+
+    while (true) {
+        nodes += weight;
+        children.clear();
+        size_t basisSize = basis.size();
+        auto expandStart = Clock::now();
+        hb.expandNode(node, basis, children);
+        seconds += weight * std::chrono::duration<double>(Clock::now() - expandStart).count();
+        // A solution met on a path need not be minimal, but every node
+        // above it is above some minimal solution of no higher level, so
+        // the real search prunes it too. Keeping it for the later paths
+        // brings their pruning closer to that of the real search.
+        if (basis.size() > basisSize) {
+            std::vector<int> solution = basis.back();
+            basis.resize(basisSize);
+            if (!hb.isGreaterThanAnyBasis(solution, basis)) {
+                basis.push_back(solution);
+                result.probeSolutions++;
+            }
+        }
+
+        if (children.empty()) return;
+        if (++level > level_limit) {
+            result.probesAtLevelLimit++;
+            return;
+        }
+        weight *= children.size();
+        node = children[std::uniform_int_distribution<size_t>(0, children.size() - 1)(rng)];
+    }
+}
+
+CostEstimate CostEstimator::estimate(const HilbertBasis& hb, std::vector<std::vector<int>> basis,
+                                     int pilotLevels, int warmupProbes, int probes, unsigned seed) {
+    CostEstimate result;
+
+    // Exact levels, as computeFrom would run them
+    auto pilotStart = Clock::now();
+    std::vector<FrontierPair> frontier = hb.initialLevel();
+    int level = 1;
+    while (!frontier.empty() && level <= pilotLevels && level <= level_limit) {
+        result.pilotNodes += frontier.size();
+        frontier = hb.nextLevel(frontier, basis);
+        level++;
+    }
+    result.pilotLevels = level - 1;
+    result.pilotSeconds = std::chrono::duration<double>(Clock::now() - pilotStart).count();
+    result.pilotSolutions = basis.size();
+    result.frontierSize = frontier.size();
+
+    if (frontier.empty() || level > level_limit || probes <= 0) {
+        result.exact = frontier.empty() || level > level_limit;
+        result.nodes = result.pilotNodes;
+        result.seconds = result.pilotSeconds;
+        return result;
+    }
+
+    std::mt19937 rng(seed);
+    double nodes = 0, seconds = 0;
+
+    // Paths that only collect solutions, so that the measured ones prune
+    // more like the real search
+    for (int p = 0; p < warmupProbes; p++) {
+        samplePath(hb, frontier, level, basis, rng, result, nodes, seconds);
+    }
+    result.probesAtLevelLimit = 0;
+
+    double sumNodes = 0, sumSquaredNodes = 0;
+    double sumSeconds = 0, sumSquaredSeconds = 0;
+    for (int p = 0; p < probes; p++) {
+        nodes = 0;
+        seconds = 0;
+        samplePath(hb, frontier, level, basis, rng, result, nodes, seconds);
+        sumNodes += nodes;
+        sumSquaredNodes += nodes * nodes;
+        sumSeconds += seconds;
+        sumSquaredSeconds += seconds * seconds;
+    }
+
+    // Sample means, and the variances of those means
+    result.probes = probes;
+    double meanNodes = sumNodes / probes;
+    double meanSeconds = sumSeconds / probes;
+    if (probes > 1) {
+        result.nodesVariance = std::max(0.0, (sumSquaredNodes - probes * meanNodes * meanNodes) / (probes - 1)) / probes;
+        result.secondsVariance = std::max(0.0, (sumSquaredSeconds - probes * meanSeconds * meanSeconds) / (probes - 1)) / probes;
+    }
+    result.nodes = result.pilotNodes + meanNodes;
+    result.seconds = result.pilotSeconds + meanSeconds;
+    return result;
+}
+
+CostEstimate CostEstimator::combine(const std::vector<CostEstimate>& estimates) {
+    CostEstimate total;
+    total.exact = true;
+    for (const auto& estimate : estimates) {
+        total.nodes += estimate.nodes;
+        total.nodesVariance += estimate.nodesVariance;
+        total.seconds += estimate.seconds;
+        total.secondsVariance += estimate.secondsVariance;
+        total.pilotNodes += estimate.pilotNodes;
+        total.pilotLevels = std::max(total.pilotLevels, estimate.pilotLevels);
+        total.pilotSeconds += estimate.pilotSeconds;
+        total.pilotSolutions += estimate.pilotSolutions;
+        total.frontierSize += estimate.frontierSize;
+        total.probes += estimate.probes;
+        total.probesAtLevelLimit += estimate.probesAtLevelLimit;
+        total.probeSolutions += estimate.probeSolutions;
+        total.exact = total.exact && estimate.exact;
+    }
+    return total;
+}
+
+void CostEstimator::printEstimate(const CostEstimate& estimate) {
+    std::cout << "Pilot: " << estimate.pilotLevels << " levels, " << estimate.pilotNodes << " nodes, "
+              << estimate.pilotSolutions << " solutions, " << estimate.pilotSeconds << " s" << std::endl;
+    if (estimate.exact) {
+        std::cout << "Search finished within the pilot levels" << std::endl;
+    } else {
+        std::cout << "Probes: " << estimate.probes << " from a frontier of " << estimate.frontierSize
+                  << " nodes, " << estimate.probeSolutions << " solutions met, "
+                  << estimate.probesAtLevelLimit << " stopped at level_limit" << std::endl;
+    }
+    std::cout << "Estimated nodes: " << estimate.nodes << " (sampling spread " << estimate.nodesLow()
+              << " - " << estimate.nodesHigh() << ")" << std::endl;
+    std::cout << "Estimated seconds: " << estimate.seconds << " (sampling spread " << estimate.secondsLow()
+              << " - " << estimate.secondsHigh() << ")" << std::endl;
+    if (!estimate.exact) {
+        std::cout << "The spread is +-2 standard errors of the path sample, not a bound on the real cost" << std::endl;
+    }
+}
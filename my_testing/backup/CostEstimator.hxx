@@ -0,0 +1,54 @@
+#pragma once
+
+#include <vector>
+#include "HilbertBasis.hxx"
+
+// Predicted size and runtime of a HilbertBasis search, with the spread of the
+// path sample (two standard errors either side). Variances are those of the
+// means, so estimates of independent searches add up with combine().
+struct CostEstimate {
+    double nodes = 0, nodesVariance = 0;
+    double seconds = 0, secondsVariance = 0;
+    long pilotNodes = 0;
+    int pilotLevels = 0;
+    double pilotSeconds = 0;
+    size_t pilotSolutions = 0;
+    long frontierSize = 0;
+    int probes = 0;
+    int probesAtLevelLimit = 0;
+    size_t probeSolutions = 0;
+    // The search finished within the pilot levels
+    bool exact = false;
+
+    double nodesLow() const;
+    double nodesHigh() const;
+    double secondsLow() const;
+    double secondsHigh() const;
+};
+
+// Estimates the cost of a search without running it to the end.
+//
+// The first pilotLevels levels are run exactly; they are cheap and find the
+// small solutions that prune everything below. From the frontier left after
+// them, random root-to-leaf paths are sampled as in Knuth's tree-size
+// estimator: a path picks one child uniformly at every node, and a node at
+// depth d counts for the product of the branching factors above it. The sum
+// over the path is an unbiased estimate of the number of nodes below the
+// frontier, and weighting the measured expansion time of every node on it the
+// same way estimates the runtime. Paths prune against the pilot basis and the
+// solutions earlier paths ran into, while the real search prunes against all
+// of the smaller solutions, so the estimate leans high. warmupProbes paths are
+// run first only to collect solutions, and do not count towards the estimate.
+//
+// The path estimates are heavy-tailed: a sample of a few thousand paths mostly
+// misses the rare deep subtrees that hold much of the cost, or hits one and
+// overshoots. On deep trees a single estimate can be several times too low or
+// too high, and the real cost often lies outside the spread. The spread only
+// measures the noise of the path sample; it is not a confidence interval.
+class CostEstimator {
+public:
+    static CostEstimate estimate(const HilbertBasis& hb, std::vector<std::vector<int>> basis,
+                                 int pilotLevels, int warmupProbes, int probes, unsigned seed);
+    static CostEstimate combine(const std::vector<CostEstimate>& estimates);
+    static void printEstimate(const CostEstimate& estimate);
+};
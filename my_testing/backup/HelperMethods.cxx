@@ -50,6 +50,32 @@ std::vector<std::vector<int>> HelperMethods::parseMonomersFile(std::string filen
     return monomers;
 }
 
+// Blocks of 1-based monomer indices, one per line, as in a covering design
+std::vector<std::vector<int>> HelperMethods::parseBlocksFile(std::string filename, size_t numMonomers) {
+    std::ifstream infile(filename);
+    if (!infile) {
+        throw std::runtime_error("Error: Unable to open file " + filename);
+    }
+
+    std::vector<std::vector<int>> blocks;
+    std::string line;
+    while (std::getline(infile, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream iss(line);
+        std::vector<int> block;
+        int index;
+        while (iss >> index) {
+            if (index < 1 || index > (int)numMonomers) {
+                throw std::invalid_argument("Block index " + std::to_string(index) + " out of range 1.." +
+                                            std::to_string(numMonomers) + ".");
+            }
+            block.push_back(index - 1);
+        }
+        if (!block.empty()) blocks.push_back(block);
+    }
+    return blocks;
+}
+
 std::vector<std::vector<int>> HelperMethods::add_unit_monomers(std::vector<std::vector<int>> monomers) {
     std::vector<std::vector<int>> result = monomers;
 
@@ -93,10 +119,29 @@ std::vector<std::vector<int>> HelperMethods::remove_unit_monomers(std::vector<st
     return trimmedBasis;
 }
 
-std::vector<int> HelperMethods::vectorAdd (std::vector<int> v1, std::vector<int> v2) {
+// Keep only the elements that do not componentwise dominate another element
+std::vector<std::vector<int>> HelperMethods::remove_dominated(std::vector<std::vector<int>> basis) {
+    std::vector<std::vector<int>> minimal;
+    for (size_t i = 0; i < basis.size(); ++i) {
+        bool dominated = false;
+        for (size_t j = 0; j < basis.size() && !dominated; ++j) {
+            if (i == j || basis[i] == basis[j]) continue;
+            dominated = std::equal(basis[i].begin(), basis[i].end(), basis[j].begin(),
+                [](int a, int b) { return a >= b; });
+        }
+        if (!dominated) {
+            minimal.push_back(basis[i]);
+        }
+    }
+    return minimal;
+}
+
+std::vector<int> HelperMethods::vectorAdd (const std::vector<int>& v1, const std::vector<int>& v2) {
     std::vector<int> result(v1.size());
     for (size_t i = 0; i < v1.size(); ++i) {
-        result[i] = v1[i] + v2[i];
+        if (__builtin_add_overflow(v1[i], v2[i], &result[i])) {
+            throw std::overflow_error("Error: Binding site sum overflows int.");
+        }
     }
     return result;
 }
@@ -125,7 +170,7 @@ bool HelperMethods::is_lex_leq(std::vector<int> a, std::vector<int> b) {
     return true; // a == b
 }
 
-void HelperMethods::printVector(std::vector<int>& v) {
+void HelperMethods::printVector(const std::vector<int>& v) {
         std::cout << "(";
         for (size_t i = 0; i < v.size(); ++i) {
             std::cout << v[i];
@@ -134,11 +179,11 @@ void HelperMethods::printVector(std::vector<int>& v) {
         std::cout << ")" << std::endl;
 }
 
-std::vector<int> HelperMethods::coeffToVector(std::vector<std::vector<int>> monomers, std::vector<int> coeff) {
+std::vector<int> HelperMethods::coeffToVector(const std::vector<std::vector<int>>& monomers, const std::vector<int>& coeff) {
     if (monomers.size() != coeff.size()) {
         std::cout << "Monomers size: " << monomers.size() << ", Coefficients size: " << coeff.size() << std::endl;
         std::cout << "Monomers: ";
-        for (auto& monomer : monomers) {
+        for (const auto& monomer : monomers) {
             printVector(monomer);
         }
         std::cout << "Coefficients: ";
@@ -149,8 +194,13 @@ std::vector<int> HelperMethods::coeffToVector(std::vector<std::vector<int>> mono
     int size = coeff.size();
     std::vector<int> actualVector(monomers[0].size(), 0);
     for (int i = 0; i < size; i++) {
+        if (coeff[i] == 0) continue;
         for (int j = 0; j < actualVector.size(); j++) {
-            actualVector[j] += coeff[i] * monomers[i][j];
+            int term;
+            if (__builtin_mul_overflow(coeff[i], monomers[i][j], &term) ||
+                __builtin_add_overflow(actualVector[j], term, &actualVector[j])) {
+                throw std::overflow_error("Error: Binding site sum overflows int.");
+            }
         }
     }
     return actualVector;
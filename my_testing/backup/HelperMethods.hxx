@@ -14,12 +14,16 @@
 class HelperMethods {
 public:
     static std::vector<std::vector<int>> parseMonomersFile(std::string filename);
+    // Blocks of 1-based monomer indices, returned 0-based
+    static std::vector<std::vector<int>> parseBlocksFile(std::string filename, size_t numMonomers);
     static std::vector<std::vector<int>> add_unit_monomers(std::vector<std::vector<int>> monomers);
-    static std::vector<int> vectorAdd(std::vector<int> v1, std::vector<int> v2);
+    static std::vector<int> vectorAdd(const std::vector<int>& v1, const std::vector<int>& v2);
     static std::vector<int> vectorSub(std::vector<int> v1, std::vector<int> v2);
     static std::vector<int> vectorNegative (std::vector<int> v);
     static bool is_lex_leq(std::vector<int> a, std::vector<int> b);
-    static void printVector(std::vector<int>& v);
-    static std::vector<int> coeffToVector(std::vector<std::vector<int>> monomers, std::vector<int> coeff);
+    static void printVector(const std::vector<int>& v);
+    // Binding-site sums are overflow checked and throw std::overflow_error
+    static std::vector<int> coeffToVector(const std::vector<std::vector<int>>& monomers, const std::vector<int>& coeff);
     static std::vector<std::vector<int>> remove_unit_monomers(std::vector<std::vector<int>> basis, int n_dim);
+    static std::vector<std::vector<int>> remove_dominated(std::vector<std::vector<int>> basis);
 };
\ No newline at end of file
@@ -0,0 +1,407 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+#include <utility>
+#include <memory>
+#include <cstdint>
+#include "HelperMethods.hxx"
+#include "SpilledFrontier.hxx"
+#include "Symmetry.hxx"
+
+// Set to 1 to enable debug output, 0 to disable
+#ifndef DEBUG
+#define DEBUG 0
+#endif
+#ifndef level_limit
+#define level_limit 200
+#endif
+// Bytes of a frontier level kept in RAM before it is spilled to disk, 0 to never spill
+#ifndef frontier_ram_budget
+#define frontier_ram_budget 0
+#endif
+#ifndef spill_dir
+#define spill_dir "/tmp"
+#endif
+// Nodes streamed back from a spilled level at a time
+#ifndef spill_chunk_nodes
+#define spill_chunk_nodes 65536
+#endif
+// Drop children with a nonzero binding site that no unfrozen monomer can cancel
+#ifndef feasibility_filter
+#define feasibility_filter 1
+#endif
+// Also drop children that cannot reach zero on every site within level_limit
+#ifndef feasibility_bound
+#define feasibility_bound 0
+#endif
+// Take the paths that reduce the most constrained nonzero site first
+// (see choosePaths)
+#ifndef dynamic_branching
+#define dynamic_branching 1
+#endif
+
+class HilbertBasis {
+public:
+    const std::vector<std::vector<int>>& monomers;
+    const int numVars;
+    const int nummonomers;
+
+    // Per binding site, bitmasks of the monomers that can lower a positive
+    // residual there (negative entry) and that can raise a negative one
+    // (positive entry), with the largest such step over all monomers
+    std::vector<std::vector<uint64_t>> lowersSite;
+    std::vector<std::vector<uint64_t>> raisesSite;
+    std::vector<int> maxLower;
+    std::vector<int> maxRaise;
+    mutable long infeasiblePruned = 0;
+    // Frontier size of every level processed by the last computeFrom (or
+    // ShardedSearch::compute, summed over the shards)
+    mutable std::vector<long> levelSizes;
+    // Print solutions as they are found
+    bool verbose = true;
+    // Automorphisms of the monomer matrix (see Symmetry). When set, frontier
+    // nodes are kept in orbit-canonical form and every solution found is
+    // added to the basis with its whole orbit.
+    std::vector<std::vector<int>> symmetries;
+
+    // Check if a vector is a solution vector (all zeros)
+    bool isSolutionVector(const std::vector<int>& vec) const {
+        return std::all_of(vec.begin(), vec.end(), [](int x) { return x == 0; });
+    }
+
+    // Check if two vectors have a negative dot product
+    bool hasNegativeDotProduct(const std::vector<int>& v1, const std::vector<int>& v2) const {
+        return std::inner_product(v1.begin(), v1.end(), v2.begin(), 0) < 0;
+    }
+
+    // Check if a vector is dominated by any basis vector
+    bool isGreaterThanAnyBasis(const std::vector<int>& vec,
+                              const std::vector<std::vector<int>>& basis) const {
+        return std::any_of(basis.begin(), basis.end(),
+            [&vec](const std::vector<int>& basisVec) {
+                return std::equal(vec.begin(), vec.end(), basisVec.begin(),
+                    [](int a, int b) { return a >= b; });
+            });
+    }
+
+    std::vector<uint64_t> unfrozenMask(const std::vector<bool>& frozenStatus) const {
+        std::vector<uint64_t> unfrozen((nummonomers + 63) / 64, 0);
+        for (int i = 0; i < nummonomers; i++) {
+            if (!frozenStatus[i]) unfrozen[i / 64] |= uint64_t(1) << (i % 64);
+        }
+        return unfrozen;
+    }
+
+    // Order in which the paths of a node are taken. Every path with a negative
+    // dot product is always branched on, since any completion of the node must
+    // contain one; only the order changes, and with it which siblings each child
+    // freezes. The default is descending index. With dynamic_branching the
+    // reducers of the most constrained nonzero site (fewest unfrozen monomers
+    // able to cancel it) come first.
+    std::vector<int> choosePaths(const std::vector<int>& actualVector,
+                                 const std::vector<bool>& frozenStatus) const {
+        std::vector<int> paths;
+        for (int i = nummonomers - 1; i >= 0; i--) {
+            if (!frozenStatus[i] && hasNegativeDotProduct(monomers[i], actualVector)) {
+                paths.push_back(i);
+            }
+        }
+        if (!dynamic_branching || paths.size() < 2) return paths;
+
+        std::vector<uint64_t> unfrozen = unfrozenMask(frozenStatus);
+        int bestSite = -1;
+        int bestCount = nummonomers + 1;
+        for (int j = 0; j < numVars; j++) {
+            if (actualVector[j] == 0) continue;
+            const std::vector<uint64_t>& mask = actualVector[j] > 0 ? lowersSite[j] : raisesSite[j];
+            int count = 0;
+            for (size_t w = 0; w < unfrozen.size(); w++) {
+                count += __builtin_popcountll(mask[w] & unfrozen[w]);
+            }
+            if (count < bestCount) {
+                bestCount = count;
+                bestSite = j;
+            }
+        }
+        if (bestSite == -1) return paths;
+
+        const std::vector<uint64_t>& mask = actualVector[bestSite] > 0 ? lowersSite[bestSite] : raisesSite[bestSite];
+        std::stable_partition(paths.begin(), paths.end(),
+            [&mask](int i) { return (mask[i / 64] >> (i % 64)) & 1; });
+        return paths;
+    }
+
+    // Move a node to the smallest image reachable by applying the symmetries
+    // one at a time. A node (c, F) leads to every minimal solution above c that
+    // uses no path in F, and (g.c, g.F) to the images of those, so any image
+    // can stand in for the node; the greedy descent need not reach the true
+    // orbit minimum.
+    void canonicalize(FrontierPair& node) const {
+        std::vector<int> coefficients = node.first.toVector();
+        bool improved = true;
+        bool moved = false;
+        while (improved) {
+            improved = false;
+            for (const auto& g : symmetries) {
+                std::vector<int> image = Symmetry::apply(g, coefficients);
+                if (image < coefficients) {
+                    coefficients = image;
+                    node.second = Symmetry::apply(g, node.second);
+                    improved = true;
+                    moved = true;
+                }
+            }
+        }
+        if (moved) {
+            node.first.assign(coefficients);
+        }
+    }
+
+    // Nodes with the same coefficients are merged into one that keeps only the
+    // paths frozen in all of them, which leads to every solution either did
+    void mergeDuplicates(std::vector<FrontierPair>& levelPairs) const {
+        std::sort(levelPairs.begin(), levelPairs.end(),
+            [](const FrontierPair& a, const FrontierPair& b) { return a.first < b.first; });
+        size_t kept = 0;
+        for (size_t i = 0; i < levelPairs.size(); i++) {
+            if (kept > 0 && levelPairs[kept - 1].first == levelPairs[i].first) {
+                for (int k = 0; k < nummonomers; k++) {
+                    levelPairs[kept - 1].second[k] = levelPairs[kept - 1].second[k] && levelPairs[i].second[k];
+                }
+            } else {
+                if (kept != i) levelPairs[kept] = std::move(levelPairs[i]);
+                kept++;
+            }
+        }
+        levelPairs.resize(kept);
+    }
+
+    // Frozen status only grows down the tree, so a site that none of the
+    // unfrozen monomers can move towards zero stays nonzero in every descendant
+    bool canClose(const std::vector<int>& actualVector, const std::vector<bool>& frozenStatus,
+                  int level) const {
+        std::vector<uint64_t> unfrozen = unfrozenMask(frozenStatus);
+
+        int stepsNeeded = 0;
+        for (int j = 0; j < numVars; j++) {
+            if (actualVector[j] == 0) continue;
+            const std::vector<uint64_t>& mask = actualVector[j] > 0 ? lowersSite[j] : raisesSite[j];
+            bool reducible = false;
+            for (size_t w = 0; w < unfrozen.size() && !reducible; w++) {
+                reducible = (mask[w] & unfrozen[w]) != 0;
+            }
+            if (!reducible) return false;
+
+            if (feasibility_bound) {
+                int step = actualVector[j] > 0 ? maxLower[j] : maxRaise[j];
+                stepsNeeded = std::max(stepsNeeded, (std::abs(actualVector[j]) + step - 1) / step);
+            }
+        }
+        return !feasibility_bound || level + stepsNeeded <= level_limit;
+    }
+
+public:
+    HilbertBasis(const std::vector<std::vector<int>>& eqs)
+        : monomers(eqs), nummonomers(eqs.size()), numVars(eqs[0].size()) {
+        size_t words = (nummonomers + 63) / 64;
+        lowersSite.assign(numVars, std::vector<uint64_t>(words, 0));
+        raisesSite.assign(numVars, std::vector<uint64_t>(words, 0));
+        maxLower.assign(numVars, 0);
+        maxRaise.assign(numVars, 0);
+        for (int i = 0; i < nummonomers; i++) {
+            for (int j = 0; j < numVars; j++) {
+                if (monomers[i][j] < 0) {
+                    lowersSite[j][i / 64] |= uint64_t(1) << (i % 64);
+                    maxLower[j] = std::max(maxLower[j], -monomers[i][j]);
+                } else if (monomers[i][j] > 0) {
+                    raisesSite[j][i / 64] |= uint64_t(1) << (i % 64);
+                    maxRaise[j] = std::max(maxRaise[j], monomers[i][j]);
+                }
+            }
+        }
+    }
+
+    // Level 1: unit vectors and their initial frozen states. Every combination
+    // hangs below the root of its highest-index monomer, so starting at
+    // firstRoot only visits combinations that use a monomer >= firstRoot.
+    std::vector<FrontierPair> initialLevel(int firstRoot = 0) const {
+        std::vector<FrontierPair> currentLevelPairs;
+        currentLevelPairs.reserve(nummonomers);
+        for (int i = firstRoot; i < nummonomers; i++) {
+            std::vector<int> unitVector(nummonomers, 0);
+            unitVector[i] = 1;
+
+            std::vector<bool> initialFrozenStatus(nummonomers, false);
+            for (int j = i + 1; j < nummonomers; j++) {
+                initialFrozenStatus[j] = true;
+            }
+            currentLevelPairs.push_back({unitVector, initialFrozenStatus});
+        }
+        if (!symmetries.empty()) {
+            for (auto& pair : currentLevelPairs) {
+                canonicalize(pair);
+            }
+            mergeDuplicates(currentLevelPairs);
+        }
+        return currentLevelPairs;
+    }
+
+    // Expand a single frontier node. Solutions are appended to basis (and true
+    // is returned), otherwise the surviving children are appended to nextLevelPairs.
+    bool expandNode(const FrontierPair& currentPair,
+                    std::vector<std::vector<int>>& basis,
+                    std::vector<FrontierPair>& nextLevelPairs) const {
+        const std::vector<int> currentCombination = currentPair.first.toVector();
+        if (DEBUG) {
+            std::cout << "Current combination: ";
+            for (const auto& val : currentCombination) {
+                std::cout << val << " ";
+            }
+            std::cout << "\n";
+        }
+
+        std::vector<bool> currentFrozenStatus = currentPair.second;
+
+        auto actualVector = HelperMethods::coeffToVector(monomers, currentCombination);
+
+        if (isSolutionVector(actualVector)) {
+            // An image of this solution may already have brought it in
+            if (!symmetries.empty() && isGreaterThanAnyBasis(currentCombination, basis)) {
+                return true;
+            }
+            basis.push_back(currentCombination);
+            if (verbose) {
+                std::cout << "Added to basis (solution vector): ";
+                for (const auto& val : currentCombination) {
+                    std::cout << val << " ";
+                }
+                std::cout << std::endl;
+            }
+            if (!symmetries.empty()) {
+                for (const auto& image : Symmetry::orbit(symmetries, currentCombination)) {
+                    if (image != currentCombination) basis.push_back(image);
+                }
+            }
+            return true;
+        }
+
+        int prevPathIdx = -1;
+
+        for (int path_taken_idx : choosePaths(actualVector, currentFrozenStatus)) {
+            auto newCombination = currentCombination;
+            newCombination[path_taken_idx]++;
+
+            // Freeze positions after the path taken
+            if (prevPathIdx != -1) {
+                currentFrozenStatus[prevPathIdx] = true;
+            }
+            std::vector<bool> newFrozenStatus = currentFrozenStatus;
+            prevPathIdx = path_taken_idx;
+
+            if (feasibility_filter) {
+                std::vector<int> childVector = HelperMethods::vectorAdd(actualVector, monomers[path_taken_idx]);
+                int childLevel = std::accumulate(newCombination.begin(), newCombination.end(), 0);
+                if (!canClose(childVector, newFrozenStatus, childLevel)) {
+                    infeasiblePruned++;
+                    continue;
+                }
+            }
+
+            if (!isGreaterThanAnyBasis(newCombination, basis)) {
+                nextLevelPairs.push_back({newCombination, newFrozenStatus});
+                if (!symmetries.empty()) {
+                    canonicalize(nextLevelPairs.back());
+                }
+            }
+        }
+        return false;
+    }
+
+    // Expand every node of a level into the next one
+    std::vector<FrontierPair> nextLevel(const std::vector<FrontierPair>& currentLevelPairs,
+                                        std::vector<std::vector<int>>& basis) const {
+        std::vector<FrontierPair> nextLevelPairs;
+        nextLevelPairs.reserve(currentLevelPairs.size() * nummonomers);
+
+        for (const auto& currentPair : currentLevelPairs) {
+            expandNode(currentPair, basis, nextLevelPairs);
+        }
+        if (!symmetries.empty()) {
+            mergeDuplicates(nextLevelPairs);
+        }
+        return nextLevelPairs;
+    }
+
+    std::vector<std::vector<int>> compute() {
+        std::vector<std::vector<int>> basis;
+        basis.reserve(nummonomers);
+        return computeFrom(initialLevel(), basis);
+    }
+
+    // Run the level loop from an arbitrary frontier. basis may be seeded with
+    // known solutions, which prune the search and are returned with the new ones.
+    std::vector<std::vector<int>> computeFrom(std::vector<FrontierPair> currentLevelPairs,
+                                              std::vector<std::vector<int>> basis,
+                                              int maxLevel = level_limit) const {
+        levelSizes.clear();
+        if (frontier_ram_budget > 0) {
+            return computeSpilled(currentLevelPairs, basis, maxLevel);
+        }
+
+        int levelCount = 1;
+
+        while (!currentLevelPairs.empty() && levelCount <= maxLevel) {
+            levelSizes.push_back(currentLevelPairs.size());
+            if (DEBUG) {
+                std::cout << "\nProcessing level " << levelCount << " with "
+                      << currentLevelPairs.size() << " pairs." << std::endl;
+            }
+
+            levelCount++;
+            currentLevelPairs = nextLevel(currentLevelPairs, basis);
+        }
+
+        return basis;
+    }
+
+    // Same level loop, with every level held in a SpilledFrontier. Dominance is
+    // checked again while a level is merged back, against the basis as it is then.
+    std::vector<std::vector<int>> computeSpilled(std::vector<FrontierPair>& firstLevelPairs,
+                                                 std::vector<std::vector<int>> basis,
+                                                 int maxLevel) const {
+        auto dominated = [&](const std::vector<int>& vec) { return isGreaterThanAnyBasis(vec, basis); };
+
+        std::unique_ptr<SpilledFrontier> currentLevel(new SpilledFrontier(frontier_ram_budget, spill_dir));
+        currentLevel->add(firstLevelPairs);
+        currentLevel->finish();
+
+        int levelCount = 1;
+        std::vector<FrontierPair> chunk;
+        std::vector<FrontierPair> nextLevelPairs;
+
+        while (!currentLevel->empty() && levelCount <= maxLevel) {
+            if (DEBUG || currentLevel->runs() > 0) {
+                std::cout << "\nProcessing level " << levelCount << " with "
+                      << currentLevel->nodes() << " pairs in " << currentLevel->runs()
+                      << " spilled runs." << std::endl;
+            }
+
+            std::unique_ptr<SpilledFrontier> nextLevel(new SpilledFrontier(frontier_ram_budget, spill_dir));
+            while (currentLevel->nextChunk(chunk, spill_chunk_nodes, dominated)) {
+                for (const auto& currentPair : chunk) {
+                    expandNode(currentPair, basis, nextLevelPairs);
+                    nextLevel->add(nextLevelPairs);
+                }
+            }
+            nextLevel->finish();
+            levelSizes.push_back(currentLevel->distinct());
+            levelCount++;
+            currentLevel = std::move(nextLevel);
+        }
+
+        return basis;
+    }
+};
@@ -0,0 +1,186 @@
+#include "IncrementalBasis.hxx"
+
+// Reads basis elements one per line, either as printed by project2 "(1, 0, 2)"
+// or as plain numbers "1 0 2". Any other line (logs, headers) is skipped.
+std::vector<std::vector<int>> IncrementalBasis::parseBasisFile(std::string filename) {
+    std::vector<std::vector<int>> basis;
+    std::ifstream infile(filename);
+
+    if (!infile) {
+        throw std::runtime_error("Error: Unable to open file " + filename);
+    }
+
+    std::string line;
+    std::regex lineRegex("^\\s*\\(?\\s*-?\\d+(\\s*,?\\s*-?\\d+)*\\s*\\)?\\s*$");
+    std::regex numberRegex("-?\\d+");
+
+    while (std::getline(infile, line)) {
+        if (!std::regex_match(line, lineRegex)) continue;
+
+        std::vector<int> element;
+        std::sregex_iterator it(line.begin(), line.end(), numberRegex);
+        std::sregex_iterator end;
+        while (it != end) {
+            element.push_back(std::stoi(it->str()));
+            ++it;
+        }
+        basis.push_back(element);
+    }
+
+    std::cout << "Parsed " << basis.size() << " basis elements from file: " << filename << std::endl;
+    return basis;
+}
+
+// Map a search-space vector back to the new monomer indexing, dropping unit monomers
+std::vector<int> IncrementalBasis::toNewIndexing(const std::vector<int>& v, const std::vector<int>& searchToNew,
+                                                 size_t numMonomers) {
+    std::vector<int> mapped(numMonomers, 0);
+    for (size_t k = 0; k < v.size(); k++) {
+        if (searchToNew[k] != -1) {
+            mapped[searchToNew[k]] = v[k];
+        }
+    }
+    return mapped;
+}
+
+std::vector<std::vector<int>> IncrementalBasis::update(const std::vector<std::vector<int>>& oldMonomers,
+                                                       const std::vector<std::vector<int>>& oldBasis,
+                                                       const std::vector<std::vector<int>>& newMonomers,
+                                                       bool unitMonomers) {
+    if (!oldMonomers.empty() && !newMonomers.empty() && oldMonomers[0].size() != newMonomers[0].size()) {
+        throw std::invalid_argument("Old and new monomers must have the same number of binding sites.");
+    }
+    int dimension = newMonomers[0].size();
+
+    // Match old monomers to new ones by value
+    std::vector<int> oldToNew(oldMonomers.size(), -1);
+    std::vector<bool> matched(newMonomers.size(), false);
+    for (size_t i = 0; i < oldMonomers.size(); i++) {
+        for (size_t j = 0; j < newMonomers.size(); j++) {
+            if (!matched[j] && newMonomers[j] == oldMonomers[i]) {
+                oldToNew[i] = j;
+                matched[j] = true;
+                break;
+            }
+        }
+    }
+
+    // Search order: kept monomers, then unit monomers, then added monomers.
+    // searchToNew maps a search index to its index in newMonomers (-1 for units).
+    std::vector<std::vector<int>> searchMonomers;
+    std::vector<int> searchToNew;
+    std::vector<int> oldToSearch(oldMonomers.size(), -1);
+    for (size_t i = 0; i < oldMonomers.size(); i++) {
+        if (oldToNew[i] != -1) {
+            oldToSearch[i] = searchMonomers.size();
+            searchMonomers.push_back(oldMonomers[i]);
+            searchToNew.push_back(oldToNew[i]);
+        }
+    }
+    int numKept = searchMonomers.size();
+
+    // A unit monomer that was hidden by a removed monomer is new to the search
+    // and goes with the added monomers. A site whose two unit monomers are both
+    // in play gives the solution e_d + (-e_d), the zero vector once unit
+    // monomers are removed.
+    std::vector<std::vector<int>> unitsAdded;
+    bool hasUnitPair = false;
+    if (unitMonomers) {
+        for (int d = 0; d < dimension; d++) {
+            int unitsInPlay = 0;
+            for (int sign : {1, -1}) {
+                std::vector<int> unitVector(dimension, 0);
+                unitVector[d] = sign;
+                if (std::find(newMonomers.begin(), newMonomers.end(), unitVector) != newMonomers.end()) {
+                    continue;
+                }
+                unitsInPlay++;
+                if (std::find(oldMonomers.begin(), oldMonomers.end(), unitVector) == oldMonomers.end()) {
+                    searchMonomers.push_back(unitVector);
+                    searchToNew.push_back(-1);
+                } else {
+                    unitsAdded.push_back(unitVector);
+                }
+            }
+            hasUnitPair = hasUnitPair || unitsInPlay == 2;
+        }
+    }
+
+    int firstAdded = searchMonomers.size();
+    for (size_t j = 0; j < newMonomers.size(); j++) {
+        if (!matched[j]) {
+            searchMonomers.push_back(newMonomers[j]);
+            searchToNew.push_back(j);
+        }
+    }
+    for (const auto& unitVector : unitsAdded) {
+        searchMonomers.push_back(unitVector);
+        searchToNew.push_back(-1);
+    }
+    int numAdded = searchMonomers.size() - firstAdded;
+
+    std::cout << "Incremental update: kept " << numKept << ", removed "
+              << (oldMonomers.size() - numKept) << ", added " << (numAdded - unitsAdded.size())
+              << " monomers" << std::endl;
+
+    // Keep every old element that does not use a removed monomer, and lift it
+    // into the search space to seed the pruning
+    std::set<std::vector<int>> result;
+    std::vector<std::vector<int>> seeds;
+    if (hasUnitPair) {
+        result.insert(std::vector<int>(newMonomers.size(), 0));
+    }
+    for (const auto& element : oldBasis) {
+        if (element.size() != oldMonomers.size()) {
+            throw std::invalid_argument("Basis element size does not match old monomers size.");
+        }
+        if (std::all_of(element.begin(), element.end(), [](int x) { return x == 0; })) {
+            continue;
+        }
+
+        bool usesRemoved = false;
+        std::vector<int> seed(searchMonomers.size(), 0);
+        for (size_t i = 0; i < element.size(); i++) {
+            if (element[i] == 0) continue;
+            if (oldToNew[i] == -1) {
+                usesRemoved = true;
+                break;
+            }
+            seed[oldToSearch[i]] = element[i];
+        }
+        if (usesRemoved) continue;
+
+        if (unitMonomers) {
+            std::vector<int> residual = HelperMethods::coeffToVector(searchMonomers, seed);
+            for (int d = 0; d < dimension; d++) {
+                if (residual[d] == 0) continue;
+                std::vector<int> unitVector(dimension, 0);
+                unitVector[d] = residual[d] > 0 ? -1 : 1;
+                auto it = std::find(searchMonomers.begin() + numKept, searchMonomers.end(), unitVector);
+                if (it != searchMonomers.end()) {
+                    seed[it - searchMonomers.begin()] += std::abs(residual[d]);
+                }
+            }
+        }
+
+        // An added monomer can take over the role of a unit monomer, so the
+        // element is reported from its lifted form
+        result.insert(toNewIndexing(seed, searchToNew, newMonomers.size()));
+
+        std::vector<int> actualVector = HelperMethods::coeffToVector(searchMonomers, seed);
+        if (std::all_of(actualVector.begin(), actualVector.end(), [](int x) { return x == 0; })) {
+            seeds.push_back(seed);
+        }
+    }
+
+    if (numAdded > 0) {
+        HilbertBasis hb(searchMonomers);
+        std::vector<std::vector<int>> found = hb.computeFrom(hb.initialLevel(firstAdded), seeds);
+
+        for (size_t b = seeds.size(); b < found.size(); b++) {
+            result.insert(toNewIndexing(found[b], searchToNew, newMonomers.size()));
+        }
+    }
+
+    return std::vector<std::vector<int>>(result.begin(), result.end());
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include "HilbertBasis.hxx"
+
+// Updates a previously computed basis after monomers are added to or removed
+// from the mixture, instead of recomputing it from scratch.
+//
+// Old monomers are matched to the new list by value. Elements of the old basis
+// that use a removed monomer are dropped; the rest lie on a face of the new
+// cone and stay in the basis. Added monomers are placed after everything else
+// in the search order, so the frozen-status search only has to start from
+// their unit vectors, with the kept elements seeding the dominance pruning.
+// With unit monomers (mode 1) the kept elements are lifted back to the full
+// search space by cancelling their residual with the unit monomers.
+class IncrementalBasis {
+public:
+    static std::vector<std::vector<int>> update(const std::vector<std::vector<int>>& oldMonomers,
+                                                const std::vector<std::vector<int>>& oldBasis,
+                                                const std::vector<std::vector<int>>& newMonomers,
+                                                bool unitMonomers);
+    static std::vector<std::vector<int>> parseBasisFile(std::string filename);
+
+private:
+    static std::vector<int> toNewIndexing(const std::vector<int>& v, const std::vector<int>& searchToNew,
+                                          size_t numMonomers);
+};
@@ -0,0 +1,134 @@
+#include "LatticeReduction.hxx"
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+
+LatticeReduction::LatticeReduction(const std::vector<std::vector<int>>& monomers)
+    : numMonomers(monomers.size()), numSites(monomers.empty() ? 0 : monomers[0].size()) {
+    // Site columns, each up to sign, without repeats or zero columns
+    std::map<std::vector<int>, int> seenColumns;
+    std::vector<std::vector<int>> sites;
+    for (int j = 0; j < numSites; j++) {
+        std::vector<int> column(numMonomers);
+        for (int i = 0; i < numMonomers; i++) {
+            column[i] = monomers[i][j];
+        }
+        auto first = std::find_if(column.begin(), column.end(), [](int x) { return x != 0; });
+        if (first == column.end()) {
+            numZeroSites++;
+            continue;
+        }
+        if (*first < 0) {
+            for (int& x : column) x = -x;
+        }
+        auto it = seenColumns.find(column);
+        if (it == seenColumns.end()) {
+            seenColumns[column] = sites.size();
+            sites.push_back(column);
+            siteCopies.push_back(1);
+        } else {
+            siteCopies[it->second]++;
+        }
+    }
+    numSitesKept = sites.size();
+
+    // Equal monomers, now over the reduced sites, are searched as one
+    std::map<std::vector<int>, int> index;
+    for (int i = 0; i < numMonomers; i++) {
+        std::vector<int> monomer(numSitesKept);
+        for (int k = 0; k < numSitesKept; k++) {
+            monomer[k] = sites[k][i];
+        }
+        auto it = index.find(monomer);
+        if (it == index.end()) {
+            index[monomer] = reduced.size();
+            reduced.push_back(monomer);
+            copies.push_back({i});
+        } else {
+            copies[it->second].push_back(i);
+        }
+    }
+}
+
+std::vector<std::vector<int>> LatticeReduction::withUnitMonomers() const {
+    // The zero sites are searched as one, so that their units still give the
+    // zero element the unreduced search returns
+    int width = numSitesKept + (numZeroSites > 0 ? 1 : 0);
+    std::vector<std::vector<int>> result = reduced;
+    for (auto& monomer : result) {
+        monomer.resize(width, 0);
+    }
+    for (int k = 0; k < width; k++) {
+        for (int sign : {1, -1}) {
+            std::vector<int> unitVector(width, 0);
+            unitVector[k] = sign;
+            if (k == numSitesKept || siteCopies[k] > 1 ||
+                std::find(result.begin(), result.end(), unitVector) == result.end()) {
+                result.push_back(unitVector);
+            }
+        }
+    }
+    return result;
+}
+
+std::vector<std::vector<int>> LatticeReduction::trivialSolutions() const {
+    return trivialSolutions(reduced);
+}
+
+std::vector<std::vector<int>> LatticeReduction::trivialSolutions(const std::vector<std::vector<int>>& monomers) {
+    std::vector<std::vector<int>> solutions;
+    for (size_t i = 0; i < monomers.size(); i++) {
+        if (std::all_of(monomers[i].begin(), monomers[i].end(), [](int x) { return x == 0; })) continue;
+        std::vector<int> negated = monomers[i];
+        for (int& x : negated) x = -x;
+        for (size_t j = i + 1; j < monomers.size(); j++) {
+            if (monomers[j] == negated) {
+                std::vector<int> pair(monomers.size(), 0);
+                pair[i] = 1;
+                pair[j] = 1;
+                solutions.push_back(pair);
+            }
+        }
+    }
+    return solutions;
+}
+
+// Every way of splitting the coefficient of each reduced monomer among its copies
+static void splitCoefficients(const std::vector<int>& element, const std::vector<std::vector<int>>& copies,
+                              size_t group, size_t copy, int remaining, std::vector<int>& current,
+                              std::vector<std::vector<int>>& out) {
+    if (group == copies.size()) {
+        out.push_back(current);
+        return;
+    }
+    const std::vector<int>& members = copies[group];
+    if (copy == 0) remaining = element[group];
+
+    if (copy + 1 == members.size()) {
+        current[members[copy]] = remaining;
+        splitCoefficients(element, copies, group + 1, 0, 0, current, out);
+        current[members[copy]] = 0;
+        return;
+    }
+    for (int take = 0; take <= remaining; take++) {
+        current[members[copy]] = take;
+        splitCoefficients(element, copies, group, copy + 1, remaining - take, current, out);
+    }
+    current[members[copy]] = 0;
+}
+
+std::vector<std::vector<int>> LatticeReduction::expand(const std::vector<std::vector<int>>& basis) const {
+    std::vector<std::vector<int>> expanded;
+    std::vector<int> current(numMonomers, 0);
+    for (const auto& element : basis) {
+        splitCoefficients(element, copies, 0, 0, 0, current, expanded);
+    }
+    return expanded;
+}
+
+void LatticeReduction::printSummary() const {
+    std::cout << "Lattice reduction: " << numSites << " -> " << numSitesKept << " binding sites, "
+              << numMonomers << " -> " << reduced.size() << " monomers, "
+              << trivialSolutions().size() << " v/-v pairs" << std::endl;
+}
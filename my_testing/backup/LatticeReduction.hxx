@@ -0,0 +1,49 @@
+#pragma once
+
+#include <vector>
+
+// Shrinks the search space before enumeration without changing the set of
+// solutions Σ c_i monomers[i] = 0.
+//
+// Binding sites: a site column that repeats another one (or its negation) or
+// is all zero adds no constraint and is dropped.
+//
+// Monomers: equal monomers are searched as one. A minimal solution over the
+// merged monomers expands to every way of splitting each merged coefficient
+// among the copies, and these are exactly the minimal solutions over the
+// original list. Pairs v, -v are minimal solutions of their own and are
+// handed to the search as known basis elements.
+class LatticeReduction {
+public:
+    LatticeReduction(const std::vector<std::vector<int>>& monomers);
+
+    // Monomers to search with, over the reduced binding sites
+    const std::vector<std::vector<int>>& reducedMonomers() const { return reduced; }
+    // The reduced monomers followed by the unit monomers of the naive algorithm,
+    // one pair per reduced site. Each such unit stands for the units of all the
+    // site columns merged into it, so the basis truncated to the reduced
+    // monomers is the one of the unreduced system with its units. As in
+    // add_unit_monomers, a unit equal to a monomer is left out, but only for
+    // a site kept from a single column: over merged columns the unreduced
+    // system has no such monomer. Sites that are zero in every monomer get
+    // one pair of units between them.
+    std::vector<std::vector<int>> withUnitMonomers() const;
+    // The v, -v pairs, as coefficient vectors over the reduced monomers
+    std::vector<std::vector<int>> trivialSolutions() const;
+    // The same over any monomer list, such as the one withUnitMonomers returns
+    static std::vector<std::vector<int>> trivialSolutions(const std::vector<std::vector<int>>& monomers);
+    // Map a basis over the reduced monomers back to the original monomers
+    std::vector<std::vector<int>> expand(const std::vector<std::vector<int>>& basis) const;
+    void printSummary() const;
+
+private:
+    int numMonomers;
+    int numSites;
+    int numSitesKept;
+    int numZeroSites = 0;
+    std::vector<std::vector<int>> reduced;
+    // Original monomer indices merged into each reduced monomer
+    std::vector<std::vector<int>> copies;
+    // Number of original site columns merged into each reduced site
+    std::vector<int> siteCopies;
+};
@@ -0,0 +1,313 @@
+#include "ShardedSearch.hxx"
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <set>
+#include <thread>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+size_t ShardedSearch::prefixHash(const std::vector<int>& coeff, int prefixLen) {
+    size_t len = (prefixLen <= 0 || prefixLen > (int)coeff.size()) ? coeff.size() : prefixLen;
+    size_t hash = len;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= coeff[i] + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+}
+
+void ShardedSearch::writeVector(std::ostream& out, const std::vector<int>& v) {
+    for (size_t i = 0; i < v.size(); i++) {
+        out << v[i];
+        if (i < v.size() - 1) out << " ";
+    }
+}
+
+std::vector<int> ShardedSearch::parseVector(const std::string& line) {
+    std::vector<int> v;
+    std::istringstream in(line);
+    int x;
+    while (in >> x) {
+        v.push_back(x);
+    }
+    return v;
+}
+
+// Pull every complete line the other shards have appended since the last sync
+void ShardedSearch::syncBasis(const std::string& workDir, int shard, int numShards,
+                              std::vector<long>& offsets, std::vector<std::vector<int>>& basis) {
+    for (int i = 0; i < numShards; i++) {
+        if (i == shard) continue;
+        std::ifstream in(workDir + "/basis_" + std::to_string(i) + ".txt");
+        if (!in) continue;
+        in.seekg(offsets[i]);
+        std::string rest((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        size_t end = rest.rfind('\n');
+        if (end == std::string::npos) continue;
+
+        std::istringstream lines(rest.substr(0, end + 1));
+        std::string line;
+        while (std::getline(lines, line)) {
+            std::vector<int> v = parseVector(line);
+            if (!v.empty()) basis.push_back(v);
+        }
+        offsets[i] += end + 1;
+    }
+}
+
+bool ShardedSearch::peerIsIdle(const std::string& workDir, int shard, int numShards) {
+    for (int i = 0; i < numShards; i++) {
+        if (i == shard) continue;
+        std::string id = std::to_string(i);
+        if (fs::exists(workDir + "/idle_" + id) && !fs::exists(workDir + "/done_" + id)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ShardedSearch::allIdle(const std::string& workDir, int numShards) {
+    for (int i = 0; i < numShards; i++) {
+        if (!fs::exists(workDir + "/idle_" + std::to_string(i))) return false;
+    }
+    // Markers are checked before chunks: a shard publishes its chunk before going idle
+    for (const auto& entry : fs::directory_iterator(workDir)) {
+        if (entry.path().filename().string().rfind("chunk_", 0) == 0) return false;
+    }
+    return true;
+}
+
+// Chunk format: first line is the level, then one node per line as
+// "<coefficients> | <frozen status>"
+void ShardedSearch::writeChunk(const std::string& workDir, int shard, int seq, int level,
+                               std::vector<FrontierPair>::const_iterator first,
+                               std::vector<FrontierPair>::const_iterator last) {
+    std::string name = "chunk_" + std::to_string(shard) + "_" + std::to_string(seq) + ".txt";
+    std::string tmpName = workDir + "/tmp_" + name;
+    {
+        std::ofstream out(tmpName);
+        out << level << "\n";
+        for (auto it = first; it != last; ++it) {
+            writeVector(out, it->first.toVector());
+            out << " |";
+            for (bool frozen : it->second) {
+                out << " " << (frozen ? 1 : 0);
+            }
+            out << "\n";
+        }
+    }
+    // Publish atomically so a thief never sees a half-written chunk
+    std::rename(tmpName.c_str(), (workDir + "/" + name).c_str());
+}
+
+bool ShardedSearch::claimChunk(const std::string& workDir, int shard,
+                               std::vector<FrontierPair>& frontier, int& level) {
+    for (const auto& entry : fs::directory_iterator(workDir)) {
+        std::string name = entry.path().filename().string();
+        if (name.rfind("chunk_", 0) != 0) continue;
+
+        std::string claimed = workDir + "/claimed_" + std::to_string(shard) + "_" + name;
+        if (std::rename(entry.path().c_str(), claimed.c_str()) != 0) {
+            continue; // another shard got there first
+        }
+
+        std::ifstream in(claimed);
+        std::string line;
+        std::getline(in, line);
+        level = std::stoi(line);
+        frontier.clear();
+        while (std::getline(in, line)) {
+            size_t bar = line.find('|');
+            if (bar == std::string::npos) continue;
+            std::vector<int> frozen = parseVector(line.substr(bar + 1));
+            frontier.push_back({parseVector(line.substr(0, bar)),
+                                std::vector<bool>(frozen.begin(), frozen.end())});
+        }
+        in.close();
+        fs::remove(claimed);
+        return true;
+    }
+    return false;
+}
+
+void ShardedSearch::runWorker(const HilbertBasis& hb, int shard, int numShards,
+                              std::vector<FrontierPair> frontier, int level,
+                              std::vector<std::vector<int>> basis, const std::string& workDir) {
+    std::string id = std::to_string(shard);
+    std::string idleMarker = workDir + "/idle_" + id;
+    std::ofstream basisOut(workDir + "/basis_" + id + ".txt", std::ios::app);
+    std::vector<long> offsets(numShards, 0);
+    long processed = 0;
+    int chunkSeq = 0;
+    long infeasibleBefore = hb.infeasiblePruned;
+    std::vector<long> levelSizes;
+
+    while (true) {
+        while (!frontier.empty() && level <= level_limit) {
+            std::vector<FrontierPair> nextLevelPairs;
+            nextLevelPairs.reserve(frontier.size() * hb.nummonomers);
+
+            for (size_t i = 0; i < frontier.size(); i++) {
+                size_t basisSize = basis.size();
+                if (hb.expandNode(frontier[i], basis, nextLevelPairs)) {
+                    for (size_t b = basisSize; b < basis.size(); b++) {
+                        writeVector(basisOut, basis[b]);
+                        basisOut << "\n";
+                    }
+                    basisOut.flush();
+                }
+
+                if (++processed % shard_sync_interval == 0) {
+                    syncBasis(workDir, shard, numShards, offsets, basis);
+
+                    // Hand the back half of what is left in this level to an idle shard
+                    size_t remaining = frontier.size() - (i + 1);
+                    if (remaining >= shard_min_steal && peerIsIdle(workDir, shard, numShards)) {
+                        size_t keep = i + 1 + remaining / 2;
+                        writeChunk(workDir, shard, chunkSeq++, level,
+                                   frontier.begin() + keep, frontier.end());
+                        frontier.resize(keep);
+                    }
+                }
+            }
+            // Nodes given away above are counted by the shard that expands them
+            if ((int)levelSizes.size() < level) levelSizes.resize(level, 0);
+            levelSizes[level - 1] += frontier.size();
+            if (!hb.symmetries.empty()) {
+                hb.mergeDuplicates(nextLevelPairs);
+            }
+            level++;
+            frontier = std::move(nextLevelPairs);
+        }
+
+        // Out of work: advertise it, then steal or wait for everybody to finish
+        std::ofstream(idleMarker).close();
+        bool gotWork = false;
+        while (!gotWork) {
+            fs::remove(idleMarker);
+            gotWork = claimChunk(workDir, shard, frontier, level);
+            if (gotWork) break;
+            std::ofstream(idleMarker).close();
+            if (allIdle(workDir, numShards)) break;
+            syncBasis(workDir, shard, numShards, offsets, basis);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        if (!gotWork) break;
+    }
+
+    writeStats(workDir, shard, hb.infeasiblePruned - infeasibleBefore, levelSizes);
+    std::ofstream(workDir + "/done_" + id).close();
+}
+
+// Stats format: infeasible nodes pruned on the first line, then the number of
+// nodes expanded at every level, starting at level 1
+void ShardedSearch::writeStats(const std::string& workDir, int shard, long infeasiblePruned,
+                               const std::vector<long>& levelSizes) {
+    std::ofstream out(workDir + "/stats_" + std::to_string(shard) + ".txt");
+    out << infeasiblePruned << "\n";
+    for (size_t i = 0; i < levelSizes.size(); i++) {
+        out << levelSizes[i];
+        if (i < levelSizes.size() - 1) out << " ";
+    }
+    out << "\n";
+}
+
+void ShardedSearch::readStats(const std::string& workDir, int shard, const HilbertBasis& hb) {
+    std::ifstream in(workDir + "/stats_" + std::to_string(shard) + ".txt");
+    long infeasiblePruned = 0;
+    if (!(in >> infeasiblePruned)) return;
+    hb.infeasiblePruned += infeasiblePruned;
+    long size;
+    for (size_t i = 0; in >> size; i++) {
+        if (hb.levelSizes.size() <= i) hb.levelSizes.push_back(0);
+        hb.levelSizes[i] += size;
+    }
+}
+
+std::vector<std::vector<int>> ShardedSearch::compute(const HilbertBasis& hb, int numShards,
+                                                     int splitLevel, int prefixLen,
+                                                     std::vector<std::vector<int>> basis) {
+    std::vector<FrontierPair> frontier = hb.initialLevel();
+    int level = 1;
+    hb.levelSizes.clear();
+
+    // Run the top of the tree in-process until the split level
+    while (!frontier.empty() && level < splitLevel && level <= level_limit) {
+        hb.levelSizes.push_back(frontier.size());
+        frontier = hb.nextLevel(frontier, basis);
+        level++;
+    }
+
+    std::string dirTemplate = std::string(spill_dir) + "/hb_shards_XXXXXX";
+    if (mkdtemp(&dirTemplate[0]) == nullptr) {
+        throw std::runtime_error("Error: Unable to create shard directory in " + std::string(spill_dir));
+    }
+    std::string workDir = dirTemplate;
+
+    std::vector<std::vector<FrontierPair>> shardFrontiers(numShards);
+    for (auto& pair : frontier) {
+        shardFrontiers[prefixHash(pair.first.toVector(), prefixLen) % numShards].push_back(std::move(pair));
+    }
+
+    std::cout << "Split at level " << level << " into " << numShards << " shards:";
+    for (const auto& f : shardFrontiers) {
+        std::cout << " " << f.size();
+    }
+    std::cout << std::endl;
+    std::fflush(stdout);
+
+    std::vector<pid_t> workers;
+    for (int s = 0; s < numShards; s++) {
+        pid_t pid = fork();
+        if (pid < 0) {
+            throw std::runtime_error("Error: fork failed for shard " + std::to_string(s));
+        }
+        if (pid == 0) {
+            int code = 0;
+            try {
+                runWorker(hb, s, numShards, std::move(shardFrontiers[s]), level, basis, workDir);
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << std::endl;
+                // Mark the shard idle and done so the others do not wait on it
+                std::ofstream(workDir + "/idle_" + std::to_string(s)).close();
+                std::ofstream(workDir + "/done_" + std::to_string(s)).close();
+                code = 1;
+            }
+            std::cout.flush();
+            _exit(code);
+        }
+        workers.push_back(pid);
+    }
+
+    bool failed = false;
+    for (pid_t pid : workers) {
+        int status = 0;
+        waitpid(pid, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            failed = true;
+        }
+    }
+
+    std::set<std::vector<int>> merged(basis.begin(), basis.end());
+    for (int s = 0; s < numShards && !failed; s++) {
+        std::ifstream in(workDir + "/basis_" + std::to_string(s) + ".txt");
+        std::string line;
+        while (std::getline(in, line)) {
+            std::vector<int> v = parseVector(line);
+            if (!v.empty()) merged.insert(v);
+        }
+        readStats(workDir, s, hb);
+    }
+    fs::remove_all(workDir);
+
+    if (failed) {
+        throw std::runtime_error("Error: a shard worker exited abnormally");
+    }
+
+    // Shards may have accepted a solution before learning about one it dominates
+    return HelperMethods::remove_dominated(std::vector<std::vector<int>>(merged.begin(), merged.end()));
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include "HilbertBasis.hxx"
+
+// Number of frontier nodes a worker expands between two reads of the other
+// shards' basis files (and between two checks for idle workers to feed)
+#ifndef shard_sync_interval
+#define shard_sync_interval 256
+#endif
+// A worker only gives work away when at least this many nodes are left in its level
+#ifndef shard_min_steal
+#define shard_min_steal 64
+#endif
+
+// Multi-process version of the frozen-status search in HilbertBasis.
+//
+// The search is run in-process up to splitLevel, then the frontier is partitioned
+// across numShards forked workers by a hash of the coefficient prefix. Workers
+// talk through files in a private directory under spill_dir:
+//   basis_<i>.txt   every solution found by shard i, one per line (read by the
+//                   other shards every shard_sync_interval nodes for pruning)
+//   idle_<i>        present while shard i has no work
+//   done_<i>        present once shard i has exited
+//   chunk_*.txt     frontier chunks handed out by a busy shard; an idle shard
+//                   claims one by renaming it
+//   stats_<i>.txt   infeasible nodes pruned and nodes expanded per level by
+//                   shard i, added into hb.infeasiblePruned and hb.levelSizes
+// basis may be seeded with known solutions, as in HilbertBasis::computeFrom.
+// The merged output is reduced to its minimal elements, so it is the same set
+// the single-process search returns.
+class ShardedSearch {
+public:
+    static std::vector<std::vector<int>> compute(const HilbertBasis& hb, int numShards,
+                                                 int splitLevel, int prefixLen,
+                                                 std::vector<std::vector<int>> basis = {});
+    static size_t prefixHash(const std::vector<int>& coeff, int prefixLen);
+
+private:
+    static void runWorker(const HilbertBasis& hb, int shard, int numShards,
+                          std::vector<FrontierPair> frontier, int level,
+                          std::vector<std::vector<int>> basis, const std::string& workDir);
+    static void syncBasis(const std::string& workDir, int shard, int numShards,
+                          std::vector<long>& offsets, std::vector<std::vector<int>>& basis);
+    static bool peerIsIdle(const std::string& workDir, int shard, int numShards);
+    static bool allIdle(const std::string& workDir, int numShards);
+    static void writeChunk(const std::string& workDir, int shard, int seq, int level,
+                           std::vector<FrontierPair>::const_iterator first,
+                           std::vector<FrontierPair>::const_iterator last);
+    static bool claimChunk(const std::string& workDir, int shard,
+                           std::vector<FrontierPair>& frontier, int& level);
+    static void writeStats(const std::string& workDir, int shard, long infeasiblePruned,
+                           const std::vector<long>& levelSizes);
+    static void readStats(const std::string& workDir, int shard, const HilbertBasis& hb);
+    static void writeVector(std::ostream& out, const std::vector<int>& v);
+    static std::vector<int> parseVector(const std::string& line);
+};
@@ -0,0 +1,340 @@
+#include "SpilledFrontier.hxx"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static void writeVarint(std::vector<unsigned char>& out, unsigned int value) {
+    while (value >= 0x80) {
+        out.push_back((unsigned char)(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back((unsigned char)value);
+}
+
+static unsigned int readVarint(const unsigned char* data, size_t& pos) {
+    unsigned int value = 0;
+    int shift = 0;
+    while (data[pos] & 0x80) {
+        value |= (unsigned int)(data[pos++] & 0x7f) << shift;
+        shift += 7;
+    }
+    value |= (unsigned int)data[pos++] << shift;
+    return value;
+}
+
+static unsigned int zigzag(int v) {
+    return ((unsigned int)v << 1) ^ (unsigned int)(v >> 31);
+}
+
+static int unzigzag(unsigned int v) {
+    return (int)(v >> 1) ^ -(int)(v & 1);
+}
+
+// Writes nodes, in sorted order, to a run file in the format read by
+// openRun and advance, flushing the encoded bytes as it goes
+class RunWriter {
+public:
+    RunWriter(const std::string& file, size_t count, size_t coeffLen, size_t frozenLen)
+        : file(file), outfile(file, std::ios::binary), prev(coeffLen, 0), frozenLen(frozenLen) {
+        writeVarint(out, count);
+        writeVarint(out, coeffLen);
+        writeVarint(out, frozenLen);
+    }
+
+    void write(const FrontierPair& node) {
+        for (size_t i = 0; i < prev.size(); i++) {
+            writeVarint(out, zigzag(node.first[i] - prev[i]));
+            prev[i] = node.first[i];
+        }
+        for (size_t i = 0; i < frozenLen; i += 8) {
+            unsigned char bits = 0;
+            for (size_t b = 0; b < 8 && i + b < frozenLen; b++) {
+                if (node.second[i + b]) bits |= 1 << b;
+            }
+            out.push_back(bits);
+        }
+        if (out.size() >= flushBytes) flush();
+    }
+
+    void close() {
+        flush();
+        outfile.close();
+        if (!outfile) {
+            throw std::runtime_error("Error: Unable to write spill run " + file);
+        }
+    }
+
+private:
+    static const size_t flushBytes = 1 << 20;
+    std::string file;
+    std::ofstream outfile;
+    std::vector<unsigned char> out;
+    std::vector<int> prev;
+    size_t frozenLen;
+
+    void flush() {
+        outfile.write((const char*)out.data(), out.size());
+        out.clear();
+    }
+};
+
+SpilledFrontier::SpilledFrontier(size_t ramBudget, std::string spillDir)
+    : ramBudget(ramBudget), spillDir(spillDir) {}
+
+SpilledFrontier::~SpilledFrontier() {
+    for (auto& run : openRuns) {
+        closeRun(run);
+    }
+    // Also takes runs left half-written or half-merged by an error
+    if (!workDir.empty()) {
+        std::error_code ec;
+        std::filesystem::remove_all(workDir, ec);
+    }
+}
+
+size_t SpilledFrontier::nodeBytes(const FrontierPair& node) {
+    return sizeof(FrontierPair) + node.first.capacityBytes() + node.second.size() / 8 + 1;
+}
+
+void SpilledFrontier::add(std::vector<FrontierPair>& nodes) {
+    for (auto& node : nodes) {
+        bufferBytes += nodeBytes(node);
+        buffer.push_back(std::move(node));
+        size++;
+        if (ramBudget > 0 && bufferBytes > ramBudget) {
+            spill();
+        }
+    }
+    nodes.clear();
+}
+
+// Path for the next run. It is recorded before anything is written, so the
+// destructor removes it even if writing fails.
+std::string SpilledFrontier::newRunFile() {
+    if (workDir.empty()) {
+        std::string dirTemplate = spillDir + "/hb_spill_XXXXXX";
+        std::vector<char> name(dirTemplate.begin(), dirTemplate.end());
+        name.push_back('\0');
+        if (mkdtemp(name.data()) == nullptr) {
+            throw std::runtime_error("Error: Unable to create spill directory in " + spillDir);
+        }
+        workDir = name.data();
+    }
+    std::string file = workDir + "/run_" + std::to_string(runsWritten++) + ".bin";
+    runFiles.push_back(file);
+    return file;
+}
+
+// Write the buffer out as one sorted, compressed run
+void SpilledFrontier::spill() {
+    if (buffer.empty()) return;
+
+    std::sort(buffer.begin(), buffer.end(),
+        [](const FrontierPair& a, const FrontierPair& b) { return a.first < b.first; });
+
+    RunWriter writer(newRunFile(), buffer.size(), buffer[0].first.size(), buffer[0].second.size());
+    for (const auto& node : buffer) {
+        writer.write(node);
+    }
+    writer.close();
+    runsSpilled++;
+
+    buffer.clear();
+    buffer.shrink_to_fit();
+    bufferBytes = 0;
+}
+
+void SpilledFrontier::finish() {
+    if (finished) return;
+    finished = true;
+
+    if (runFiles.empty()) {
+        std::sort(buffer.begin(), buffer.end(),
+            [](const FrontierPair& a, const FrontierPair& b) { return a.first < b.first; });
+        return;
+    }
+    spill();
+    while (runFiles.size() > spill_merge_fanin) {
+        mergePass();
+    }
+    openRunsForMerge();
+}
+
+// Map a run and read its header; advance then decodes the nodes one by one
+void SpilledFrontier::openRun(const std::string& file, Run& run) {
+    int fd = open(file.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Error: Unable to open spill run " + file);
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        throw std::runtime_error("Error: Unable to open spill run " + file);
+    }
+    run.length = st.st_size;
+    void* data = mmap(nullptr, run.length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        throw std::runtime_error("Error: Unable to map spill run " + file);
+    }
+    madvise(data, run.length, MADV_SEQUENTIAL);
+    run.data = (const unsigned char*)data;
+    run.pos = 0;
+
+    run.remaining = readVarint(run.data, run.pos);
+    size_t coeffLen = readVarint(run.data, run.pos);
+    size_t frozenLen = readVarint(run.data, run.pos);
+    run.current.first.assign(std::vector<int>(coeffLen, 0));
+    run.current.second.assign(frozenLen, false);
+}
+
+void SpilledFrontier::closeRun(Run& run) {
+    if (run.data != nullptr) {
+        munmap((void*)run.data, run.length);
+        run.data = nullptr;
+    }
+}
+
+// Merge the first spill_merge_fanin runs into one. Duplicates are kept;
+// nextChunk merges them on the final pass.
+void SpilledFrontier::mergePass() {
+    std::vector<std::string> inputs(runFiles.begin(), runFiles.begin() + spill_merge_fanin);
+    std::vector<Run> runs(inputs.size());
+    std::vector<size_t> mergeHeap;
+    size_t count = 0, coeffLen = 0, frozenLen = 0;
+    try {
+        for (size_t r = 0; r < inputs.size(); r++) {
+            openRun(inputs[r], runs[r]);
+            count += runs[r].remaining;
+            coeffLen = runs[r].current.first.size();
+            frozenLen = runs[r].current.second.size();
+            if (advance(runs[r])) {
+                mergeHeap.push_back(r);
+            }
+        }
+        auto greater = [&runs](size_t a, size_t b) { return runs[a].current.first > runs[b].current.first; };
+        std::make_heap(mergeHeap.begin(), mergeHeap.end(), greater);
+
+        RunWriter writer(newRunFile(), count, coeffLen, frozenLen);
+        while (!mergeHeap.empty()) {
+            std::pop_heap(mergeHeap.begin(), mergeHeap.end(), greater);
+            size_t r = mergeHeap.back();
+            writer.write(runs[r].current);
+            if (advance(runs[r])) {
+                std::push_heap(mergeHeap.begin(), mergeHeap.end(), greater);
+            } else {
+                mergeHeap.pop_back();
+            }
+        }
+        writer.close();
+    } catch (...) {
+        for (auto& run : runs) {
+            closeRun(run);
+        }
+        throw;
+    }
+
+    for (auto& run : runs) {
+        closeRun(run);
+    }
+    for (const auto& file : inputs) {
+        std::remove(file.c_str());
+    }
+    runFiles.erase(runFiles.begin(), runFiles.begin() + inputs.size());
+}
+
+void SpilledFrontier::openRunsForMerge() {
+    openRuns.resize(runFiles.size());
+    for (size_t r = 0; r < runFiles.size(); r++) {
+        openRun(runFiles[r], openRuns[r]);
+        if (advance(openRuns[r])) {
+            heap.push_back(r);
+        }
+    }
+    auto greater = [this](size_t a, size_t b) { return openRuns[a].current.first > openRuns[b].current.first; };
+    std::make_heap(heap.begin(), heap.end(), greater);
+}
+
+// Decode the next node of a run into run.current
+bool SpilledFrontier::advance(Run& run) {
+    if (run.remaining == 0) return false;
+    run.remaining--;
+
+    CoeffVector& coeff = run.current.first;
+    for (size_t i = 0; i < coeff.size(); i++) {
+        int delta = unzigzag(readVarint(run.data, run.pos));
+        if (delta != 0) coeff.set(i, coeff[i] + delta);
+    }
+    std::vector<bool>& frozen = run.current.second;
+    for (size_t i = 0; i < frozen.size(); i += 8) {
+        unsigned char bits = run.data[run.pos++];
+        for (size_t b = 0; b < 8 && i + b < frozen.size(); b++) {
+            frozen[i + b] = (bits >> b) & 1;
+        }
+    }
+    return true;
+}
+
+void SpilledFrontier::pushBack(FrontierPair& node) {
+    peeked = std::move(node);
+    hasPeeked = true;
+}
+
+bool SpilledFrontier::popNext(FrontierPair& node) {
+    if (hasPeeked) {
+        node = std::move(peeked);
+        hasPeeked = false;
+        return true;
+    }
+    if (runFiles.empty()) {
+        if (memoryPos >= buffer.size()) return false;
+        node = std::move(buffer[memoryPos++]);
+        return true;
+    }
+
+    if (heap.empty()) return false;
+    auto greater = [this](size_t a, size_t b) { return openRuns[a].current.first > openRuns[b].current.first; };
+    std::pop_heap(heap.begin(), heap.end(), greater);
+    size_t r = heap.back();
+    heap.pop_back();
+    node = openRuns[r].current;
+    if (advance(openRuns[r])) {
+        heap.push_back(r);
+        std::push_heap(heap.begin(), heap.end(), greater);
+    }
+    return true;
+}
+
+bool SpilledFrontier::nextChunk(std::vector<FrontierPair>& chunk, size_t maxNodes,
+                                const std::function<bool(const std::vector<int>&)>& dominated) {
+    finish();
+    chunk.clear();
+
+    FrontierPair node;
+    while (chunk.size() < maxNodes && popNext(node)) {
+        // Nodes come out sorted, so duplicates are adjacent. They are merged
+        // into one node that keeps only the paths frozen in all of them.
+        FrontierPair next;
+        while (popNext(next)) {
+            if (next.first != node.first) {
+                pushBack(next);
+                break;
+            }
+            for (size_t i = 0; i < node.second.size(); i++) {
+                node.second[i] = node.second[i] && next.second[i];
+            }
+        }
+        if (dominated && dominated(node.first.toVector())) continue;
+        chunk.push_back(std::move(node));
+        emitted++;
+    }
+    return !chunk.empty();
+}
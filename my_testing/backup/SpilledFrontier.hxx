@@ -0,0 +1,90 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <functional>
+#include <utility>
+#include "CoeffVector.hxx"
+
+// Most runs mapped and merged at once. A level with more runs is first merged
+// in passes of this many runs into fewer, longer ones.
+#ifndef spill_merge_fanin
+#define spill_merge_fanin 64
+#endif
+
+// A frontier node: coefficient vector plus the frozen status of every path
+// (project1 leaves the frozen status empty)
+typedef std::pair<CoeffVector, std::vector<bool>> FrontierPair;
+
+// One level of the search frontier that can outgrow RAM.
+//
+// Nodes are buffered in memory until they exceed the byte budget, then the
+// buffer is sorted by coefficient vector and written to disk as a compressed
+// run (each coefficient is zigzag/varint encoded as a delta against the
+// previous node, frozen bits are packed). Reading the level back is a k-way
+// merge over the runs, which are mmap'd and consumed sequentially; equal
+// coefficient vectors are merged into one node and dominated nodes are dropped
+// on the way out. A level that never hits the budget stays in memory.
+//
+// Errors creating, writing or mapping a run throw std::runtime_error. The
+// destructor removes the spill directory with everything in it, so a caller
+// that catches the error leaves nothing behind.
+class SpilledFrontier {
+public:
+    SpilledFrontier(size_t ramBudget, std::string spillDir = "/tmp");
+    ~SpilledFrontier();
+
+    void add(std::vector<FrontierPair>& nodes);
+    // No more nodes will be added; prepares the level for reading
+    void finish();
+    // Fill chunk with up to maxNodes distinct, non-dominated nodes in sorted order.
+    // Returns false once the level is exhausted.
+    bool nextChunk(std::vector<FrontierPair>& chunk, size_t maxNodes,
+                   const std::function<bool(const std::vector<int>&)>& dominated);
+
+    bool empty() const { return size == 0; }
+    // Nodes added, counting duplicates
+    size_t nodes() const { return size; }
+    // Nodes handed out by nextChunk so far
+    size_t distinct() const { return emitted; }
+    // Runs spilled while the level was built, before any merge pass
+    size_t runs() const { return runsSpilled; }
+
+private:
+    struct Run {
+        const unsigned char* data = nullptr;
+        size_t length = 0;
+        size_t pos = 0;
+        size_t remaining = 0;
+        FrontierPair current;
+    };
+
+    size_t ramBudget;
+    std::string spillDir;
+    std::string workDir;
+    size_t size = 0;
+    size_t emitted = 0;
+    size_t bufferBytes = 0;
+    size_t memoryPos = 0;
+    size_t runsSpilled = 0;
+    size_t runsWritten = 0;
+    bool finished = false;
+    std::vector<FrontierPair> buffer;
+    std::vector<std::string> runFiles;
+    std::vector<Run> openRuns;
+    std::vector<size_t> heap;
+    FrontierPair peeked;
+    bool hasPeeked = false;
+
+    static size_t nodeBytes(const FrontierPair& node);
+    std::string newRunFile();
+    void spill();
+    static void openRun(const std::string& file, Run& run);
+    static void closeRun(Run& run);
+    static bool advance(Run& run);
+    void mergePass();
+    void openRunsForMerge();
+    bool popNext(FrontierPair& node);
+    // Return the last popped node, popNext hands it out again
+    void pushBack(FrontierPair& node);
+};
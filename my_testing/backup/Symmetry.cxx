@@ -0,0 +1,208 @@
+#include "Symmetry.hxx"
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <set>
+
+// Color refinement of the monomer/site matrix: a site's color is refined by
+// the multiset of (entry, monomer color) over its column, taken up to sign,
+// and a monomer's color by the multiset of (|entry|, site color) over its row,
+// until the number of monomer colors stops growing. Only equally colored
+// monomers can be swapped by an automorphism.
+static std::vector<int> monomerColors(const std::vector<std::vector<int>>& monomers) {
+    int n = monomers.size();
+    int d = n == 0 ? 0 : monomers[0].size();
+    std::vector<int> rowColor(n, 0), colColor(d, 0);
+    int numColors = -1;
+
+    while (true) {
+        std::map<std::vector<int>, int> colIds;
+        std::vector<int> newColColor(d);
+        for (int j = 0; j < d; j++) {
+            // A site may be swapped with its complement
+            std::vector<int> signature, negated;
+            for (int i = 0; i < n; i++) {
+                if (monomers[i][j] != 0) {
+                    signature.push_back(monomers[i][j] * (n + 1) + rowColor[i]);
+                    negated.push_back(-monomers[i][j] * (n + 1) + rowColor[i]);
+                }
+            }
+            std::sort(signature.begin(), signature.end());
+            std::sort(negated.begin(), negated.end());
+            signature = std::min(signature, negated);
+            signature.insert(signature.begin(), colColor[j]);
+            newColColor[j] = colIds.emplace(signature, colIds.size()).first->second;
+        }
+        colColor = newColColor;
+
+        std::map<std::vector<int>, int> rowIds;
+        std::vector<int> newRowColor(n);
+        for (int i = 0; i < n; i++) {
+            std::vector<int> signature;
+            for (int j = 0; j < d; j++) {
+                if (monomers[i][j] != 0) {
+                    signature.push_back(std::abs(monomers[i][j]) * (d + 1) + colColor[j]);
+                }
+            }
+            std::sort(signature.begin(), signature.end());
+            signature.insert(signature.begin(), rowColor[i]);
+            newRowColor[i] = rowIds.emplace(signature, rowIds.size()).first->second;
+        }
+        rowColor = newRowColor;
+
+        if ((int)rowIds.size() == numColors) break;
+        numColors = rowIds.size();
+    }
+    return rowColor;
+}
+
+// A column up to the sign of the whole column
+static void signNormalize(std::vector<int>& column) {
+    for (int x : column) {
+        if (x > 0) return;
+        if (x < 0) {
+            for (int& y : column) y = -y;
+            return;
+        }
+    }
+}
+
+// The first rows of the matrix, moved by image, must have the same multiset
+// of site columns (up to sign) as they had before. With all rows placed this
+// is exactly the existence of the site permutation.
+bool Symmetry::prefixMatches(const std::vector<std::vector<int>>& monomers, const std::vector<int>& image,
+                             int rows) {
+    int d = monomers[0].size();
+    std::vector<std::vector<int>> before(d, std::vector<int>(rows));
+    std::vector<std::vector<int>> after(d, std::vector<int>(rows));
+    for (int j = 0; j < d; j++) {
+        for (int i = 0; i < rows; i++) {
+            before[j][i] = monomers[i][j];
+            after[j][i] = monomers[image[i]][j];
+        }
+        signNormalize(before[j]);
+        signNormalize(after[j]);
+    }
+    std::sort(before.begin(), before.end());
+    std::sort(after.begin(), after.end());
+    return before == after;
+}
+
+bool Symmetry::extend(const std::vector<std::vector<int>>& monomers, const std::vector<int>& rowClass,
+                      std::vector<int>& image, std::vector<bool>& used, int row, long& steps, long searchLimit) {
+    int n = monomers.size();
+    if (row == n) return true;
+
+    // Try the row itself first, most automorphisms fix most monomers
+    std::vector<int> candidates;
+    if (!used[row]) candidates.push_back(row);
+    for (int y = 0; y < n; y++) {
+        if (y != row && !used[y] && rowClass[y] == rowClass[row]) candidates.push_back(y);
+    }
+
+    for (int y : candidates) {
+        if (++steps > searchLimit) return false;
+        image[row] = y;
+        if (!prefixMatches(monomers, image, row + 1)) continue;
+        used[y] = true;
+        if (extend(monomers, rowClass, image, used, row + 1, steps, searchLimit)) return true;
+        used[y] = false;
+    }
+    return false;
+}
+
+// Monomers reachable from start under the generators that fix 0..start-1
+static std::set<int> pointOrbit(const std::vector<std::vector<int>>& generators, int start) {
+    std::set<int> orbit = {start};
+    std::vector<int> queue = {start};
+    while (!queue.empty()) {
+        int x = queue.back();
+        queue.pop_back();
+        for (const auto& g : generators) {
+            bool fixesPrefix = true;
+            for (int i = 0; i < start && fixesPrefix; i++) {
+                fixesPrefix = g[i] == i;
+            }
+            if (fixesPrefix && orbit.insert(g[x]).second) {
+                queue.push_back(g[x]);
+            }
+        }
+    }
+    return orbit;
+}
+
+std::vector<std::vector<int>> Symmetry::generators(const std::vector<std::vector<int>>& monomers,
+                                                   long searchLimit) {
+    std::vector<std::vector<int>> generators;
+    int n = monomers.size();
+    if (n == 0) return generators;
+
+    std::vector<int> rowClass = monomerColors(monomers);
+    long steps = 0;
+
+    // Deepest stabilizer first, so an orbit point already reached through
+    // earlier generators needs no search of its own
+    for (int k = n - 1; k >= 0 && steps <= searchLimit; k--) {
+        std::set<int> orbit = pointOrbit(generators, k);
+        for (int x = k + 1; x < n && steps <= searchLimit; x++) {
+            if (rowClass[x] != rowClass[k] || orbit.count(x)) continue;
+
+            std::vector<int> image(n);
+            std::vector<bool> used(n, false);
+            for (int i = 0; i < k; i++) {
+                image[i] = i;
+                used[i] = true;
+            }
+            image[k] = x;
+            used[x] = true;
+            if (!prefixMatches(monomers, image, k + 1)) continue;
+            if (extend(monomers, rowClass, image, used, k + 1, steps, searchLimit)) {
+                generators.push_back(image);
+                orbit = pointOrbit(generators, k);
+            }
+        }
+    }
+    return generators;
+}
+
+double Symmetry::groupOrder(const std::vector<std::vector<int>>& generators, int numMonomers) {
+    double order = 1;
+    for (int k = 0; k < numMonomers; k++) {
+        order *= pointOrbit(generators, k).size();
+    }
+    return order;
+}
+
+std::vector<int> Symmetry::apply(const std::vector<int>& permutation, const std::vector<int>& v) {
+    std::vector<int> image(v.size());
+    for (size_t i = 0; i < v.size(); i++) {
+        image[permutation[i]] = v[i];
+    }
+    return image;
+}
+
+std::vector<bool> Symmetry::apply(const std::vector<int>& permutation, const std::vector<bool>& v) {
+    std::vector<bool> image(v.size());
+    for (size_t i = 0; i < v.size(); i++) {
+        image[permutation[i]] = v[i];
+    }
+    return image;
+}
+
+std::vector<std::vector<int>> Symmetry::orbit(const std::vector<std::vector<int>>& generators,
+                                              const std::vector<int>& v) {
+    std::set<std::vector<int>> seen = {v};
+    std::vector<std::vector<int>> queue = {v};
+    while (!queue.empty()) {
+        std::vector<int> current = queue.back();
+        queue.pop_back();
+        for (const auto& g : generators) {
+            std::vector<int> image = apply(g, current);
+            if (seen.insert(image).second) {
+                queue.push_back(image);
+            }
+        }
+    }
+    return std::vector<std::vector<int>>(seen.begin(), seen.end());
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <vector>
+
+// Automorphisms of the monomer matrix: permutations sigma of the monomers for
+// which some permutation tau of the binding sites, each site possibly swapped
+// with its complement (sign s), gives monomers[sigma[i]][tau[j]] ==
+// s[j] * monomers[i][j]. Such a sigma maps solutions to solutions (and minimal
+// ones to minimal ones), acting on a coefficient vector c as
+// (sigma . c)[sigma[i]] = c[i].
+//
+// generators() returns coset representatives along the stabilizer chain of
+// monomers 0, 1, 2, ..., which generate the whole group. The search gives up
+// after searchLimit backtracking steps; the generators found so far are still
+// automorphisms, the group is then only partially used.
+class Symmetry {
+public:
+    static std::vector<std::vector<int>> generators(const std::vector<std::vector<int>>& monomers,
+                                                    long searchLimit);
+    // Order of the group generated, from the orbit sizes along the chain
+    static double groupOrder(const std::vector<std::vector<int>>& generators, int numMonomers);
+    static std::vector<int> apply(const std::vector<int>& permutation, const std::vector<int>& v);
+    static std::vector<bool> apply(const std::vector<int>& permutation, const std::vector<bool>& v);
+    // Every image of v under the group generated
+    static std::vector<std::vector<int>> orbit(const std::vector<std::vector<int>>& generators,
+                                               const std::vector<int>& v);
+
+private:
+    static bool extend(const std::vector<std::vector<int>>& monomers, const std::vector<int>& rowClass,
+                       std::vector<int>& image, std::vector<bool>& used, int row, long& steps, long searchLimit);
+    static bool prefixMatches(const std::vector<std::vector<int>>& monomers, const std::vector<int>& image,
+                              int rows);
+};
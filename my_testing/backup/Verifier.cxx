@@ -0,0 +1,315 @@
+#include "Verifier.hxx"
+#include "IncrementalBasis.hxx"
+
+#include <atomic>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
+std::vector<std::vector<int>> Verifier::parseNormalizOutput(std::string filename) {
+    std::vector<std::vector<int>> basis;
+    std::ifstream infile(filename);
+
+    if (!infile) {
+        throw std::runtime_error("Error: Unable to open file " + filename);
+    }
+
+    std::string line;
+    bool inSection = false;
+    while (std::getline(infile, line)) {
+        if (!inSection) {
+            inSection = line.find("Hilbert basis elements:") != std::string::npos;
+            continue;
+        }
+        // The section ends at the first blank line or the next heading
+        std::istringstream iss(line);
+        std::vector<int> element;
+        int x;
+        while (iss >> x) {
+            element.push_back(x);
+        }
+        if (element.empty()) {
+            if (line.find_first_not_of(" \t\r") == std::string::npos) break;
+            if (line.find("***") != std::string::npos || line.find(':') != std::string::npos) break;
+            continue;
+        }
+        basis.push_back(element);
+    }
+
+    std::cout << "Parsed " << basis.size() << " Hilbert basis elements from Normaliz output: " << filename << std::endl;
+    return basis;
+}
+
+std::vector<std::vector<int>> Verifier::loadCandidate(std::string filename, size_t numMonomers) {
+    std::ifstream infile(filename);
+    if (!infile) {
+        throw std::runtime_error("Error: Unable to open file " + filename);
+    }
+    std::stringstream contents;
+    contents << infile.rdbuf();
+    bool normaliz = contents.str().find("Hilbert basis elements:") != std::string::npos;
+
+    std::vector<std::vector<int>> basis = normaliz ? parseNormalizOutput(filename)
+                                                   : IncrementalBasis::parseBasisFile(filename);
+    for (auto& element : basis) {
+        if (element.size() < numMonomers) {
+            throw std::invalid_argument("Basis element has " + std::to_string(element.size()) +
+                                        " entries, expected " + std::to_string(numMonomers) + ".");
+        }
+        element.resize(numMonomers);
+    }
+    return basis;
+}
+
+bool Verifier::sumsToZero(const std::vector<std::vector<int>>& monomers, const std::vector<int>& v) {
+    std::vector<int> total = HelperMethods::coeffToVector(monomers, v);
+    return std::all_of(total.begin(), total.end(), [](int x) { return x == 0; });
+}
+
+// Walks every split v = b + c with b <=lex c, keeping the site sums of b
+// up to date, and stops at the first split where b and c share no
+// complementary site.
+static bool findSplit(const std::vector<std::vector<int>>& monomers, const std::vector<int>& v,
+                      const std::vector<int>& support, const std::vector<int>& total, size_t k,
+                      bool tied, bool nonzero, std::vector<int>& partial) {
+    if (k == support.size()) {
+        if (!nonzero) return false;
+        for (size_t j = 0; j < total.size(); j++) {
+            if ((long long)partial[j] * (total[j] - partial[j]) < 0) return false;
+        }
+        return true;
+    }
+
+    int i = support[k];
+    const std::vector<int>& monomer = monomers[i];
+    int maxTake = tied ? v[i] / 2 : v[i];
+    bool found = false;
+    int take = 0;
+    for (; take <= maxTake && !found; take++) {
+        if (take > 0) {
+            for (size_t j = 0; j < partial.size(); j++) partial[j] += monomer[j];
+        }
+        found = findSplit(monomers, v, support, total, k + 1, tied && 2 * take == v[i],
+                          nonzero || take > 0, partial);
+    }
+    // Undo the site sums added on this level
+    for (int t = 1; t < take; t++) {
+        for (size_t j = 0; j < partial.size(); j++) partial[j] -= monomer[j];
+    }
+    return found;
+}
+
+bool Verifier::isUnsplittable(const std::vector<std::vector<int>>& monomers, const std::vector<int>& v) {
+    std::vector<int> support;
+    for (size_t i = 0; i < v.size(); i++) {
+        if (v[i] < 0) return false;
+        if (v[i] > 0) support.push_back(i);
+    }
+    if (support.empty()) return false;
+
+    std::vector<int> total = HelperMethods::coeffToVector(monomers, v);
+    std::vector<int> partial(total.size(), 0);
+    return !findSplit(monomers, v, support, total, 0, true, false, partial);
+}
+
+void Verifier::parallelFor(size_t count, int numThreads, size_t batchSize,
+                           const std::function<void(size_t)>& body) {
+    if (numThreads <= 0) {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    std::atomic<size_t> next(0);
+    std::atomic<bool> failed(false);
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    auto worker = [&]() {
+        try {
+            while (!failed) {
+                size_t first = next.fetch_add(batchSize);
+                if (first >= count) return;
+                size_t last = std::min(count, first + batchSize);
+                for (size_t i = first; i < last; i++) {
+                    body(i);
+                }
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error) error = std::current_exception();
+            failed = true;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    try {
+        for (int t = 1; t < numThreads; t++) {
+            threads.emplace_back(worker);
+        }
+    } catch (const std::system_error&) {
+        // Fewer threads than asked for; the ones started share the work
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+std::vector<int> Verifier::lift(const std::vector<std::vector<int>>& monomers, const std::vector<int>& v) {
+    std::vector<int> lifted = v;
+    for (int x : HelperMethods::coeffToVector(monomers, v)) {
+        lifted.push_back(x < 0 ? -x : 0);
+        lifted.push_back(x > 0 ? x : 0);
+    }
+    return lifted;
+}
+
+std::vector<std::vector<int>> Verifier::minimalElements(const std::vector<std::vector<int>>& monomers,
+                                                        const std::vector<std::vector<int>>& basis,
+                                                        bool unitMonomers, int numThreads) {
+    std::vector<std::vector<int>> compared = basis;
+    if (unitMonomers) {
+        parallelFor(basis.size(), numThreads, 256, [&](size_t i) {
+            compared[i] = lift(monomers, basis[i]);
+        });
+    }
+    DominanceIndex index(compared);
+    std::vector<char> keep(basis.size(), 0);
+    parallelFor(basis.size(), numThreads, 256, [&](size_t i) {
+        keep[i] = !index.dominatesAnother(compared[i]);
+    });
+
+    std::vector<std::vector<int>> minimal;
+    for (size_t i = 0; i < basis.size(); i++) {
+        if (keep[i]) minimal.push_back(basis[i]);
+    }
+    return minimal;
+}
+
+double Verifier::binomial(size_t n, size_t k) {
+    if (k > n) return 0;
+    double count = 1;
+    for (size_t i = 1; i <= k; i++) {
+        count = count * (n - k + i) / i;
+    }
+    return count;
+}
+
+std::vector<std::vector<int>> Verifier::subsetsOfSize(size_t numMonomers, size_t size) {
+    size = std::min(size, numMonomers);
+    std::vector<std::vector<int>> subsets;
+    std::vector<int> subset(size);
+    std::iota(subset.begin(), subset.end(), 0);
+    while (true) {
+        subsets.push_back(subset);
+        // Advance the rightmost index that still has room
+        int k = size - 1;
+        while (k >= 0 && subset[k] == (int)(numMonomers - size + k)) k--;
+        if (k < 0) break;
+        subset[k]++;
+        for (size_t l = k + 1; l < size; l++) {
+            subset[l] = subset[l - 1] + 1;
+        }
+    }
+    return subsets;
+}
+
+std::vector<Verifier::SupportResult> Verifier::checkSupports(const std::vector<std::vector<int>>& monomers,
+                                                             const std::vector<std::vector<int>>& basis,
+                                                             bool unitMonomers,
+                                                             const std::vector<std::vector<int>>& supports,
+                                                             int numThreads) {
+    std::set<std::vector<int>> candidate(basis.begin(), basis.end());
+
+    // add_unit_monomers skips units equal to a monomer, so each support gets
+    // the units of the whole system rather than those of its own monomers
+    std::vector<std::vector<int>> units;
+    if (unitMonomers) {
+        std::vector<std::vector<int>> augmented = HelperMethods::add_unit_monomers(monomers);
+        units.assign(augmented.begin() + monomers.size(), augmented.end());
+    }
+
+    std::vector<SupportResult> results;
+    for (const auto& support : supports) {
+        SupportResult result;
+        result.support = support;
+        results.push_back(result);
+    }
+
+    // One search per support, so batches of one
+    parallelFor(results.size(), numThreads, 1, [&](size_t r) {
+        SupportResult& result = results[r];
+        std::vector<std::vector<int>> subMonomers;
+        for (int i : result.support) {
+            subMonomers.push_back(monomers[i]);
+        }
+        subMonomers.insert(subMonomers.end(), units.begin(), units.end());
+        HilbertBasis hb(subMonomers);
+        hb.verbose = false;
+        std::vector<std::vector<int>> found = hb.compute();
+
+        std::set<std::vector<int>> expected;
+        for (const auto& element : found) {
+            std::vector<int> full(monomers.size(), 0);
+            bool nonzero = false;
+            for (size_t k = 0; k < result.support.size(); k++) {
+                full[result.support[k]] = element[k];
+                nonzero = nonzero || element[k] != 0;
+            }
+            if (nonzero) expected.insert(full);
+        }
+        for (const auto& element : expected) {
+            if (!candidate.count(element)) {
+                result.missing.push_back(element);
+            }
+        }
+    });
+    return results;
+}
+
+DominanceIndex::DominanceIndex(const std::vector<std::vector<int>>& elements) {
+    std::map<std::vector<uint64_t>, size_t> groupOf;
+    for (const auto& element : elements) {
+        std::vector<uint64_t> mask = supportMask(element);
+        auto it = groupOf.find(mask);
+        if (it == groupOf.end()) {
+            it = groupOf.emplace(mask, groups.size()).first;
+            groups.push_back({mask, INT32_MAX, {}});
+        }
+        Group& group = groups[it->second];
+        group.elements.push_back(&element);
+        group.minSum = std::min(group.minSum, std::accumulate(element.begin(), element.end(), 0));
+    }
+}
+
+std::vector<uint64_t> DominanceIndex::supportMask(const std::vector<int>& v) {
+    std::vector<uint64_t> mask((v.size() + 63) / 64, 0);
+    for (size_t i = 0; i < v.size(); i++) {
+        if (v[i] != 0) mask[i / 64] |= uint64_t(1) << (i % 64);
+    }
+    return mask;
+}
+
+bool DominanceIndex::dominatesAnother(const std::vector<int>& v) const {
+    std::vector<uint64_t> mask = supportMask(v);
+    int sum = std::accumulate(v.begin(), v.end(), 0);
+
+    for (const auto& group : groups) {
+        if (group.minSum > sum) continue;
+        bool contained = true;
+        for (size_t w = 0; w < mask.size() && contained; w++) {
+            contained = (group.mask[w] & ~mask[w]) == 0;
+        }
+        if (!contained) continue;
+
+        for (const std::vector<int>* element : group.elements) {
+            if (*element == v) continue;
+            if (std::equal(v.begin(), v.end(), element->begin(), [](int a, int b) { return a >= b; })) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <functional>
+#include <cstdint>
+#include "HelperMethods.hxx"
+
+// Certifies a candidate basis against its monomers, e.g. the union that
+// combined_pipeline.py collects over covering blocks.
+//
+// Every element is checked to be unsplittable in the sense of project3: each
+// split v = b + c into nonzero parts leaves some binding site where b and c
+// complement each other. With unitMonomers off (plain Hilbert basis) elements
+// must also sum to zero, and unsplittable then means minimal. Elements that
+// pass are reduced to the minimal ones through a DominanceIndex shared by all
+// threads. With unit monomers every polymer containing monomer i lies above
+// e_i, so dominance is decided on the elements lifted by the unit monomers
+// that cancel their residual, as project2 searches them in mode 1.
+//
+// Finally sets of monomer types are searched on their own with HilbertBasis,
+// together with the unit monomers of the whole system. A minimal element whose
+// support lies inside such a set is minimal in the set's search and the other
+// way around, so every element found there that the candidate lacks is missing
+// from it. The sets come from the monomers, not from the candidate: either
+// every set of a given size, which covers every support up to that size, or
+// the blocks of a covering design.
+//
+// Work is handed out to the threads in batches of indices. The first exception
+// thrown by any thread stops the hand-out and is rethrown by parallelFor once
+// every thread has finished.
+class Verifier {
+public:
+    struct SupportResult {
+        std::vector<int> support;
+        // Elements of the support's basis absent from the candidate
+        std::vector<std::vector<int>> missing;
+    };
+
+    // Reads the "Hilbert basis elements:" section of a Normaliz .out file
+    static std::vector<std::vector<int>> parseNormalizOutput(std::string filename);
+    // Reads a Normaliz .out file or a numeric basis file (as parsed by
+    // IncrementalBasis::parseBasisFile). Longer elements, like Normaliz vectors
+    // with singleton columns, are cut to numMonomers entries.
+    static std::vector<std::vector<int>> loadCandidate(std::string filename, size_t numMonomers);
+
+    static bool sumsToZero(const std::vector<std::vector<int>>& monomers, const std::vector<int>& v);
+    static bool isUnsplittable(const std::vector<std::vector<int>>& monomers, const std::vector<int>& v);
+
+    static void parallelFor(size_t count, int numThreads, size_t batchSize,
+                            const std::function<void(size_t)>& body);
+
+    // v followed by the number of +e_j and -e_j unit monomers cancelling its residual
+    static std::vector<int> lift(const std::vector<std::vector<int>>& monomers, const std::vector<int>& v);
+    // Elements of basis that do not dominate another element
+    static std::vector<std::vector<int>> minimalElements(const std::vector<std::vector<int>>& monomers,
+                                                         const std::vector<std::vector<int>>& basis,
+                                                         bool unitMonomers, int numThreads);
+
+    // Number of ways to pick k of n monomers, as a double so it cannot overflow
+    static double binomial(size_t n, size_t k);
+    // Every set of size monomers out of numMonomers, or all of them if there are fewer
+    static std::vector<std::vector<int>> subsetsOfSize(size_t numMonomers, size_t size);
+    static std::vector<SupportResult> checkSupports(const std::vector<std::vector<int>>& monomers,
+                                                    const std::vector<std::vector<int>>& basis,
+                                                    bool unitMonomers,
+                                                    const std::vector<std::vector<int>>& supports,
+                                                    int numThreads);
+};
+
+// Finds whether an element lies componentwise above another one. Elements are
+// grouped by support bitmask; a group can only hold such an element when its
+// support is contained in the query's and its smallest coefficient sum is not
+// larger. Read-only after construction, so one index serves every thread.
+class DominanceIndex {
+public:
+    DominanceIndex(const std::vector<std::vector<int>>& elements);
+    bool dominatesAnother(const std::vector<int>& v) const;
+
+private:
+    struct Group {
+        std::vector<uint64_t> mask;
+        int minSum;
+        std::vector<const std::vector<int>*> elements;
+    };
+    std::vector<Group> groups;
+
+    static std::vector<uint64_t> supportMask(const std::vector<int>& v);
+};
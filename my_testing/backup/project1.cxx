@@ -5,16 +5,22 @@
 #include <chrono>
 #include <string>
 #include <numeric>
+#include <memory>
+#include <stdexcept>
+#include "SpilledFrontier.hxx"
 
 // Set to 1 to enable debug output, 0 to disable
 #define DEBUG 0
+#define frontier_ram_budget 0 // bytes of a level kept in RAM before it is spilled to disk, 0 to never spill
+#define spill_dir "/tmp"
+#define spill_chunk_nodes 65536 // vectors streamed back from a spilled level at a time
 
 // Add a hash function for vectors to use with unordered_set
 struct VectorHash {
-    size_t operator()(const std::vector<int>& v) const {
+    size_t operator()(const CoeffVector& v) const {
         size_t hash = v.size();
-        for (auto& i : v) {
-            hash ^= i + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        for (size_t k = 0; k < v.size(); k++) {
+            hash ^= v[k] + 0x9e3779b9 + (hash << 6) + (hash >> 2);
         }
         return hash;
     }
@@ -25,7 +31,7 @@ private:
     const std::vector<std::vector<int>>& equations;  // Changed to reference
     const int numVars;
     const int numEquations;
-    std::unordered_set<std::vector<int>, VectorHash> seenVectors;  // Cache seen vectors
+    std::unordered_set<CoeffVector, VectorHash> seenVectors;  // Cache seen vectors, stored narrow
 
     // Optimized actual vector calculation using vector operations
     std::vector<int> calculateActualVector(const std::vector<int>& combination) {
@@ -33,7 +39,11 @@ private:
         for (int i = 0; i < numEquations; i++) {
             if (combination[i] != 0) {  // Skip if coefficient is 0
                 for (int j = 0; j < numVars; j++) {
-                    result[j] += combination[i] * equations[i][j];
+                    int term;
+                    if (__builtin_mul_overflow(combination[i], equations[i][j], &term) ||
+                        __builtin_add_overflow(result[j], term, &result[j])) {
+                        throw std::overflow_error("Error: Equation sum overflows int.");
+                    }
                 }
             }
         }
@@ -59,6 +69,68 @@ private:
             });
     }
 
+    // Expand one vector of the current level into nextLevel
+    void expandVector(const std::vector<int>& current, std::vector<std::vector<int>>& basis,
+                      std::vector<CoeffVector>& nextLevel) {
+        auto actualVector = calculateActualVector(current);
+        
+#if DEBUG
+        // Print current vector and its actual vector
+        std::cout << "(";
+        for (size_t i = 0; i < current.size(); i++) {
+            std::cout << current[i];
+            if (i < current.size() - 1) std::cout << ",";
+        }
+        std::cout << ") -> Actual: (";
+        for (size_t i = 0; i < actualVector.size(); i++) {
+            std::cout << actualVector[i];
+            if (i < actualVector.size() - 1) std::cout << ",";
+        }
+        std::cout << ")" << std::endl;
+#endif
+        
+        if (isSolutionVector(actualVector)) {
+            basis.push_back(current);
+#if DEBUG
+            std::cout << "  → Added to basis (solution vector)" << std::endl;
+#endif
+            return;
+        }
+
+#if DEBUG
+        // Print valid paths
+        std::cout << "  Valid paths: ";
+        bool anyValid = false;
+#endif
+
+        for (int i = 0; i < numEquations; i++) {
+            if (hasNegativeDotProduct(equations[i], actualVector)) {
+#if DEBUG
+                if (anyValid) std::cout << ", ";
+                std::cout << "path " << i;
+                anyValid = true;
+#endif
+                
+                auto newCombination = current;
+                newCombination[i]++;
+                
+                // Use seenVectors cache to avoid duplicates (a spilled level
+                // drops them while it is merged back instead)
+                if (!isGreaterThanAnyBasis(newCombination, basis) &&
+                    (frontier_ram_budget > 0 || seenVectors.insert(newCombination).second)) {
+                    nextLevel.push_back(std::move(newCombination));
+#if DEBUG
+                    std::cout << " (added)";
+#endif
+                }
+            }
+        }
+#if DEBUG
+        if (!anyValid) std::cout << "none";
+        std::cout << std::endl;
+#endif
+    }
+
 public:
     HilbertBasis(const std::vector<std::vector<int>>& eqs) 
         : equations(eqs), numEquations(eqs.size()), numVars(eqs[0].size()) {
@@ -67,7 +139,7 @@ public:
 
     std::vector<std::vector<int>> compute() {
         std::vector<std::vector<int>> basis;
-        std::vector<std::vector<int>> currentLevel;
+        std::vector<CoeffVector> currentLevel;
         basis.reserve(100);  // Prereserve space
         currentLevel.reserve(100);
         
@@ -78,9 +150,13 @@ public:
             currentLevel.push_back(std::move(unitVector));
         }
 
+        if (frontier_ram_budget > 0) {
+            return computeSpilled(currentLevel, basis);
+        }
+
         int levelCount = 0;
         while (!currentLevel.empty() && levelCount++ < 18) {
-            std::vector<std::vector<int>> nextLevel;
+            std::vector<CoeffVector> nextLevel;
             nextLevel.reserve(currentLevel.size() * numEquations);
 
 #if DEBUG
@@ -97,62 +173,7 @@ public:
 #endif
 
             for (const auto& current : currentLevel) {
-                auto actualVector = calculateActualVector(current);
-                
-#if DEBUG
-                // Print current vector and its actual vector
-                std::cout << "(";
-                for (size_t i = 0; i < current.size(); i++) {
-                    std::cout << current[i];
-                    if (i < current.size() - 1) std::cout << ",";
-                }
-                std::cout << ") -> Actual: (";
-                for (size_t i = 0; i < actualVector.size(); i++) {
-                    std::cout << actualVector[i];
-                    if (i < actualVector.size() - 1) std::cout << ",";
-                }
-                std::cout << ")" << std::endl;
-#endif
-                
-                if (isSolutionVector(actualVector)) {
-                    basis.push_back(current);
-#if DEBUG
-                    std::cout << "  → Added to basis (solution vector)" << std::endl;
-#endif
-                    continue;
-                }
-
-#if DEBUG
-                // Print valid paths
-                std::cout << "  Valid paths: ";
-                bool anyValid = false;
-#endif
-
-                for (int i = 0; i < numEquations; i++) {
-                    if (hasNegativeDotProduct(equations[i], actualVector)) {
-#if DEBUG
-                        if (anyValid) std::cout << ", ";
-                        std::cout << "path " << i;
-                        anyValid = true;
-#endif
-                        
-                        auto newCombination = current;
-                        newCombination[i]++;
-                        
-                        // Use seenVectors cache to avoid duplicates
-                        if (!isGreaterThanAnyBasis(newCombination, basis) && 
-                            seenVectors.insert(newCombination).second) {
-                            nextLevel.push_back(std::move(newCombination));
-#if DEBUG
-                            std::cout << " (added)";
-#endif
-                        }
-                    }
-                }
-#if DEBUG
-                if (!anyValid) std::cout << "none";
-                std::cout << std::endl;
-#endif
+                expandVector(current.toVector(), basis, nextLevel);
             }
 
 
@@ -168,6 +189,52 @@ public:
         
         return basis;
     }
+
+    // Same level loop with every level held in a SpilledFrontier, which replaces
+    // seenVectors: vectors of one level all have the same coefficient sum, so
+    // duplicates can only meet inside a level and are dropped while it is merged.
+    std::vector<std::vector<int>> computeSpilled(std::vector<CoeffVector>& firstLevel,
+                                                 std::vector<std::vector<int>>& basis) {
+        auto dominated = [&](const std::vector<int>& vec) { return isGreaterThanAnyBasis(vec, basis); };
+        std::vector<FrontierPair> pairs;
+        for (auto& vec : firstLevel) {
+            pairs.push_back({std::move(vec), {}});
+        }
+
+        std::unique_ptr<SpilledFrontier> currentLevel(new SpilledFrontier(frontier_ram_budget, spill_dir));
+        currentLevel->add(pairs);
+        currentLevel->finish();
+
+        int levelCount = 0;
+        std::vector<FrontierPair> chunk;
+        std::vector<CoeffVector> nextVectors;
+        while (!currentLevel->empty() && levelCount++ < 18) {
+            std::unique_ptr<SpilledFrontier> nextLevel(new SpilledFrontier(frontier_ram_budget, spill_dir));
+
+            while (currentLevel->nextChunk(chunk, spill_chunk_nodes, dominated)) {
+                for (const auto& current : chunk) {
+                    expandVector(current.first.toVector(), basis, nextVectors);
+                    for (auto& vec : nextVectors) {
+                        pairs.push_back({std::move(vec), {}});
+                    }
+                    nextVectors.clear();
+                    nextLevel->add(pairs);
+                }
+            }
+            nextLevel->finish();
+
+            std::cout << "\nLevel " << levelCount << " Summary:" << std::endl;
+            std::cout << "Current Level Size: " << currentLevel->distinct() << std::endl;
+            std::cout << "Next Level Size: " << nextLevel->nodes() << " before merging, in "
+                      << nextLevel->runs() << " spilled runs" << std::endl;
+            std::cout << "Current Basis Size: " << basis.size() << std::endl;
+            std::cout << "------------------------" << std::endl;
+
+            currentLevel = std::move(nextLevel);
+        }
+
+        return basis;
+    }
 };
 
 // Example usage
@@ -199,7 +266,13 @@ int main() {
     auto start = std::chrono::high_resolution_clock::now();
 
     HilbertBasis hb(equations);
-    std::vector<std::vector<int>> basis = hb.compute();
+    std::vector<std::vector<int>> basis;
+    try {
+        basis = hb.compute();
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
 
     // End timing
     auto end = std::chrono::high_resolution_clock::now();
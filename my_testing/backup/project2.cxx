@@ -6,143 +6,48 @@
 #include <numeric>
 #include <sstream>
 #include <fstream>
+#include <set>
 #include "HelperMethods.hxx"
 
-// Set to 1 to enable debug output, 0 to disable
-#define DEBUG 0
-#define level_limit 200
+// Search settings shared with the other translation units (DEBUG, level_limit,
+// frontier_ram_budget, ...) are in HilbertBasis.hxx
 #define mode 1 // 0 for Hilbert Basis, 1 for naive algorithm
-
-class HilbertBasis {
-public:
-    const std::vector<std::vector<int>>& monomers;
-    const int numVars;
-    const int nummonomers;
-
-    // Check if a vector is a solution vector (all zeros)
-    bool isSolutionVector(const std::vector<int>& vec) const {
-        return std::all_of(vec.begin(), vec.end(), [](int x) { return x == 0; });
-    }
-
-    // Check if two vectors have a negative dot product
-    bool hasNegativeDotProduct(const std::vector<int>& v1, const std::vector<int>& v2) const {
-        return std::inner_product(v1.begin(), v1.end(), v2.begin(), 0) < 0;
-    }
-
-    // Check if a vector is dominated by any basis vector
-    bool isGreaterThanAnyBasis(const std::vector<int>& vec, 
-                              const std::vector<std::vector<int>>& basis) const {
-        return std::any_of(basis.begin(), basis.end(),
-            [&vec](const std::vector<int>& basisVec) {
-                return std::equal(vec.begin(), vec.end(), basisVec.begin(),
-                    [](int a, int b) { return a >= b; });
-            });
-    }
-
-public:
-    HilbertBasis(const std::vector<std::vector<int>>& eqs) 
-        : monomers(eqs), nummonomers(eqs.size()), numVars(eqs[0].size()) {}
-
-    std::vector<std::vector<int>> compute() {
-        std::vector<std::vector<int>> basis;
-        std::vector<std::pair<std::vector<int>, std::vector<bool>>> currentLevelPairs;
-        
-        basis.reserve(nummonomers);
-        currentLevelPairs.reserve(nummonomers);
-        // Start at level 1 with unit vectors and their initial frozen states
-        for (int i = 0; i < nummonomers; i++) {
-            std::vector<int> unitVector(nummonomers, 0);
-            unitVector[i] = 1;
-
-            std::vector<bool> initialFrozenStatus(nummonomers, false);
-            for (int j = i + 1; j < nummonomers; j++) {
-                initialFrozenStatus[j] = true;
-            }
-            currentLevelPairs.push_back({unitVector, initialFrozenStatus});
-        }
-        
-        int levelCount = 1;
-        
-        while (!currentLevelPairs.empty() && levelCount <= level_limit) {
-            if (DEBUG) {
-                std::cout << "\nProcessing level " << levelCount << " with " 
-                      << currentLevelPairs.size() << " pairs." << std::endl;
-            }
-            
-            std::vector<std::pair<std::vector<int>, std::vector<bool>>> nextLevelPairs;
-            nextLevelPairs.reserve(currentLevelPairs.size() * nummonomers);
-    
-            for (const auto& currentPair : currentLevelPairs) {
-                if (DEBUG) {
-                    std::cout << "Current combination: ";
-                    for (const auto& val : currentPair.first) {
-                        std::cout << val << " ";
-                    }
-                    std::cout << "\n";
-                }
-                
-                const std::vector<int>& currentCombination = currentPair.first;
-                std::vector<bool> currentFrozenStatus = currentPair.second;
-                
-                auto actualVector = HelperMethods::coeffToVector(monomers, currentCombination);
-                
-                if (isSolutionVector(actualVector)) {
-                    basis.push_back(currentCombination);
-                    std::cout << "Added to basis (solution vector): ";
-                    for (const auto& val : currentCombination) {
-                        std::cout << val << " ";
-                    }
-                    std::cout << std::endl;
-                    continue;
-                }
-                
-                std::vector<bool> possiblePaths = currentFrozenStatus;
-                int prevPathIdx = -1;
-
-                for (int path_taken_idx = nummonomers - 1; path_taken_idx >= 0; path_taken_idx--) {
-                    if (currentFrozenStatus[path_taken_idx]) {
-                        continue;
-                    }
-                    
-                    if (hasNegativeDotProduct(monomers[path_taken_idx], actualVector)) {
-                        auto newCombination = currentCombination;
-                        newCombination[path_taken_idx]++;
-                        
-                        // Freeze positions after the path taken
-                        if (prevPathIdx != -1) {
-                            currentFrozenStatus[prevPathIdx] = true;
-                        }
-                        std::vector<bool> newFrozenStatus = currentFrozenStatus;
-                        prevPathIdx = path_taken_idx;
-                        
-                        if (!isGreaterThanAnyBasis(newCombination, basis)) {
-                            nextLevelPairs.push_back({newCombination, newFrozenStatus});
-                        }
-                    }
-                }
-            }
-            levelCount++;
-            currentLevelPairs = std::move(nextLevelPairs);
-        }
-        
-        return basis;
-    }
-};
+#define shards 1 // >1 splits the search across that many worker processes
+#define shard_split_level 3 // level at which the frontier is partitioned across shards
+#define shard_prefix_len 0 // coefficients hashed to pick a shard, 0 for all of them
+#define branch_order 0 // 0 input order, 1 by binding-site degree, 2 by site constrainedness, -1 probe all three
+#define branch_probe_levels 8 // levels each ordering is run for when probing
+#define branch_stats 1 // print the frontier size of every level
+#define symmetry 1 // search orbit representatives under automorphisms of the monomer matrix
+#define symmetry_search_limit 1000000 // backtracking steps spent looking for automorphisms
+#define lattice_reduction 1 // drop redundant binding sites and merge equal monomers before searching
+
+#include "HilbertBasis.hxx"
+#include "ShardedSearch.hxx"
+#include "IncrementalBasis.hxx"
+#include "BranchOrder.hxx"
+#include "Symmetry.hxx"
+#include "LatticeReduction.hxx"
+#include <memory>
 
 // Example usage
 int main(int argc, char* argv[]) {
     std::vector<std::vector<int>> monomers;
+    std::vector<std::vector<int>> oldMonomers;
+    std::vector<std::vector<int>> oldBasis;
     int og_monomers_size = 0;
-    if (argc < 2) {
-        std::cerr << "Usage: " << argv[0] << " <input_file>" << std::endl;
+    if (argc < 2 || argc == 3) {
+        std::cerr << "Usage: " << argv[0] << " <input_file> [<old_input_file> <old_basis_file>]" << std::endl;
         return 1;
     }
 
+    // Incremental update from the basis of an earlier version of the mixture
+    bool incremental = argc >= 4;
     try {
         monomers = HelperMethods::parseMonomersFile(argv[1]);
-        if (mode == 1) {
-            og_monomers_size = monomers.size();
-            monomers = HelperMethods::add_unit_monomers(monomers);
+        if (incremental) {
+            oldMonomers = HelperMethods::parseMonomersFile(argv[2]);
+            oldBasis = IncrementalBasis::parseBasisFile(argv[3]);
         }
     } catch (const std::exception& e) {
         std::cerr << e.what() << std::endl;
@@ -151,11 +56,86 @@ int main(int argc, char* argv[]) {
     
     auto start = std::chrono::high_resolution_clock::now();
 
-    HilbertBasis hb(monomers);
-    std::vector<std::vector<int>> basis = hb.compute();
-    if (mode == 1) {
-        std::cout << "Naive algorithm mode enabled. Removing unit monomers." << std::endl;
-        basis = HelperMethods::remove_unit_monomers(basis, og_monomers_size);
+    std::vector<std::vector<int>> basis;
+    if (incremental) {
+        try {
+            basis = IncrementalBasis::update(oldMonomers, oldBasis, monomers, mode == 1);
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+    } else {
+        // Search over fewer sites and monomers and expand the basis afterwards.
+        // Reduced before the unit monomers are added: each unit only covers its
+        // own site, so no site would repeat another one after that.
+        std::unique_ptr<LatticeReduction> lattice;
+        std::vector<std::vector<int>> knownSolutions;
+        if (lattice_reduction) {
+            lattice.reset(new LatticeReduction(monomers));
+            lattice->printSummary();
+            monomers = lattice->reducedMonomers();
+            knownSolutions = lattice->trivialSolutions();
+        }
+        if (mode == 1) {
+            og_monomers_size = monomers.size();
+            if (lattice) {
+                monomers = lattice->withUnitMonomers();
+                knownSolutions = LatticeReduction::trivialSolutions(monomers);
+            } else {
+                monomers = HelperMethods::add_unit_monomers(monomers);
+            }
+        }
+
+        // Search in a better monomer order and map the basis back afterwards
+        int strategy = branch_order;
+        if (strategy == BranchOrder::PROBE) {
+            strategy = BranchOrder::probe(monomers, branch_probe_levels);
+        }
+        std::vector<int> searchOrder = BranchOrder::order(monomers, strategy);
+        monomers = BranchOrder::apply(monomers, searchOrder);
+        knownSolutions = BranchOrder::reorder(knownSolutions, searchOrder);
+
+        HilbertBasis hb(monomers);
+        if (symmetry) {
+            hb.symmetries = Symmetry::generators(monomers, symmetry_search_limit);
+            std::cout << "Symmetry group of order " << Symmetry::groupOrder(hb.symmetries, monomers.size())
+                      << " (" << hb.symmetries.size() << " generators)" << std::endl;
+            // Known solutions prune the nodes that canonicalize onto them, so the
+            // images those nodes would have led to must be known as well
+            std::set<std::vector<int>> closed;
+            for (const auto& solution : knownSolutions) {
+                for (const auto& image : Symmetry::orbit(hb.symmetries, solution)) {
+                    closed.insert(image);
+                }
+            }
+            knownSolutions.assign(closed.begin(), closed.end());
+        }
+
+        try {
+            if (shards > 1) {
+                basis = ShardedSearch::compute(hb, shards, shard_split_level, shard_prefix_len, knownSolutions);
+            } else {
+                basis = hb.computeFrom(hb.initialLevel(), knownSolutions);
+            }
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+        if (feasibility_filter) {
+            std::cout << "Infeasible nodes pruned: " << hb.infeasiblePruned << std::endl;
+        }
+        if (branch_stats) {
+            BranchOrder::printLevelSizes(hb.levelSizes);
+        }
+
+        basis = BranchOrder::restore(basis, searchOrder);
+        if (mode == 1) {
+            std::cout << "Naive algorithm mode enabled. Removing unit monomers." << std::endl;
+            basis = HelperMethods::remove_unit_monomers(basis, og_monomers_size);
+        }
+        if (lattice) {
+            basis = lattice->expand(basis);
+        }
     }
 
     // End timing
@@ -0,0 +1,196 @@
+#include <vector>
+#include <algorithm>
+#include <iostream>
+#include <chrono>
+#include <string>
+#include <set>
+#include <fstream>
+#include "HelperMethods.hxx"
+#include "Verifier.hxx"
+
+#define mode 1 // 0 if the candidate is a plain Hilbert basis (elements sum to zero), 1 if unit monomers were allowed
+#define verify_threads 0 // worker threads, 0 for one per core
+#define support_check_limit 8 // every set of this many monomer types is searched for completeness
+#define support_check_max_searches 20000 // the set size is lowered until there are no more sets than this
+
+// Basis verifier: certifies and minimizes a candidate basis
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <monomers_file> <basis_file> [<output_file> [<blocks_file>]]" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::vector<int>> monomers;
+    std::vector<std::vector<int>> candidate;
+    std::vector<std::vector<int>> blocks;
+    try {
+        monomers = HelperMethods::parseMonomersFile(argv[1]);
+        candidate = Verifier::loadCandidate(argv[2], monomers.size());
+        // Search the blocks of a covering design instead of every set of a size
+        if (argc >= 5) {
+            blocks = HelperMethods::parseBlocksFile(argv[4], monomers.size());
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    std::set<std::vector<int>> unique;
+    for (const auto& element : candidate) {
+        if (std::any_of(element.begin(), element.end(), [](int x) { return x != 0; })) {
+            unique.insert(element);
+        }
+    }
+    std::vector<std::vector<int>> elements(unique.begin(), unique.end());
+    std::cout << "Verifying " << elements.size() << " distinct elements (" << candidate.size() << " read)" << std::endl;
+
+    // Zero sum and unsplittability, one flag per element
+    std::vector<char> notZeroSum(elements.size(), 0), splittable(elements.size(), 0);
+    try {
+        Verifier::parallelFor(elements.size(), verify_threads, 64, [&](size_t i) {
+            if (mode == 0 && !Verifier::sumsToZero(monomers, elements[i])) {
+                notZeroSum[i] = 1;
+            } else if (!Verifier::isUnsplittable(monomers, elements[i])) {
+                splittable[i] = 1;
+            }
+        });
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    std::vector<std::vector<int>> valid;
+    for (size_t i = 0; i < elements.size(); i++) {
+        if (notZeroSum[i]) {
+            std::cout << "Does not sum to zero: ";
+            HelperMethods::printVector(elements[i]);
+        } else if (splittable[i]) {
+            std::cout << "Splittable: ";
+            HelperMethods::printVector(elements[i]);
+        } else {
+            valid.push_back(elements[i]);
+        }
+    }
+
+    std::vector<std::vector<int>> minimal;
+    try {
+        minimal = Verifier::minimalElements(monomers, valid, mode == 1, verify_threads);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    std::cout << "Dominated elements dropped: " << valid.size() - minimal.size() << std::endl;
+
+    // Monomer types that no element uses
+    std::vector<int> unused;
+    for (size_t i = 0; i < monomers.size(); i++) {
+        if (std::none_of(minimal.begin(), minimal.end(), [i](const std::vector<int>& v) { return v[i] != 0; })) {
+            unused.push_back(i);
+        }
+    }
+
+    // Sets of monomer types to search, taken from the monomers so that
+    // supports the candidate never uses are searched as well
+    size_t setSize = std::min<size_t>(support_check_limit, monomers.size());
+    while (setSize > 1 && Verifier::binomial(monomers.size(), setSize) > support_check_max_searches) {
+        setSize--;
+    }
+    std::vector<std::vector<int>> searchSets = blocks.empty() ? Verifier::subsetsOfSize(monomers.size(), setSize)
+                                                              : blocks;
+
+    // Elements whose support lies in no searched set could have missing
+    // neighbours that no search sees
+    size_t outside = 0;
+    for (const auto& element : minimal) {
+        std::vector<int> support;
+        for (size_t i = 0; i < element.size(); i++) {
+            if (element[i] != 0) support.push_back(i);
+        }
+        bool inside = false;
+        if (blocks.empty()) {
+            inside = support.size() <= setSize;
+        }
+        for (const auto& block : blocks) {
+            std::set<int> members(block.begin(), block.end());
+            inside = inside || std::all_of(support.begin(), support.end(), [&](int i) { return members.count(i); });
+        }
+        if (!inside) outside++;
+    }
+
+    std::vector<Verifier::SupportResult> supports;
+    try {
+        supports = Verifier::checkSupports(monomers, minimal, mode == 1, searchSets, verify_threads);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    int incomplete = 0;
+    std::set<std::vector<int>> missing;
+    for (const auto& result : supports) {
+        if (result.missing.empty()) continue;
+        incomplete++;
+        missing.insert(result.missing.begin(), result.missing.end());
+        std::cout << "Incomplete set {";
+        for (size_t i = 0; i < result.support.size(); i++) {
+            std::cout << result.support[i] << (i + 1 < result.support.size() ? ", " : "");
+        }
+        std::cout << "}: " << result.missing.size() << " missing" << std::endl;
+    }
+    for (const auto& element : missing) {
+        std::cout << "Missing from the candidate: ";
+        HelperMethods::printVector(element);
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+    std::cout << "\nVerification summary:" << std::endl;
+    if (mode == 0) {
+        std::cout << "Not summing to zero: " << std::count(notZeroSum.begin(), notZeroSum.end(), 1) << std::endl;
+    }
+    std::cout << "Splittable: " << std::count(splittable.begin(), splittable.end(), 1) << std::endl;
+    std::cout << "Dominated: " << valid.size() - minimal.size() << std::endl;
+    std::cout << "Certified minimal elements: " << minimal.size() << std::endl;
+    std::cout << "Missing elements: " << missing.size() << " (from " << incomplete << " of "
+              << supports.size() << " searched sets)" << std::endl;
+    std::cout << "Complete sets: " << supports.size() - incomplete << " of " << supports.size()
+              << (incomplete > 0 ? ", every searched set not listed as incomplete above" : "") << std::endl;
+    if (!blocks.empty()) {
+        std::cout << "Searched sets: the blocks of " << argv[4] << std::endl;
+        std::cout << "Not checked: supports inside no block (" << outside
+                  << " certified elements have one)" << std::endl;
+    } else if (setSize == monomers.size()) {
+        std::cout << "Searched sets: the whole system" << std::endl;
+    } else {
+        std::cout << "Searched sets: every " << setSize << " of the " << monomers.size() << " monomer types" << std::endl;
+        std::cout << "Not checked: supports of more than " << setSize << " monomer types (" << outside
+                  << " certified elements have one)" << std::endl;
+    }
+    std::cout << "Monomers used by no element: " << unused.size();
+    for (int i : unused) {
+        std::cout << " " << i;
+    }
+    std::cout << std::endl;
+
+    if (argc >= 4) {
+        std::ofstream out(argv[3]);
+        if (!out) {
+            std::cerr << "Error: Unable to write file " << argv[3] << std::endl;
+            return 1;
+        }
+        out << "# Certified minimal elements, n_monomers=" << monomers.size() << "\n";
+        for (const auto& element : minimal) {
+            for (size_t i = 0; i < element.size(); i++) {
+                out << element[i] << (i + 1 < element.size() ? " " : "\n");
+            }
+        }
+        std::cout << "Wrote " << minimal.size() << " elements to " << argv[3] << std::endl;
+    }
+
+    std::cout << "\nExecution time: " << duration.count() << " microseconds";
+    std::cout << " (" << duration.count() / 1000.0 << " milliseconds)" << std::endl;
+
+    return 0;
+}
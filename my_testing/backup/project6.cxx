@@ -0,0 +1,96 @@
+#include <vector>
+#include <algorithm>
+#include <iostream>
+#include <chrono>
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <stdexcept>
+#include "HelperMethods.hxx"
+
+#define mode 1 // 0 for Hilbert Basis, 1 for naive algorithm (unit monomers added), as in project2
+#define lattice_reduction 1 // estimate the search over the reduced system, as project2 runs it
+#define branch_order 0 // 0 input order, 1 by binding-site degree, 2 by site constrainedness
+#define estimate_levels 6 // levels run exactly before sampling
+#define estimate_warmup_probes 2000 // paths run first only to collect solutions for pruning
+#define estimate_probes 2000 // random root-to-leaf paths sampled per system
+#define estimate_seed 1
+
+#include "HilbertBasis.hxx"
+#include "BranchOrder.hxx"
+#include "LatticeReduction.hxx"
+#include "CostEstimator.hxx"
+
+// Set up the system the way project2 searches it and estimate that search
+static CostEstimate estimateSystem(std::vector<std::vector<int>> monomers, unsigned seed) {
+    std::vector<std::vector<int>> knownSolutions;
+    if (lattice_reduction) {
+        LatticeReduction lattice(monomers);
+        monomers = mode == 1 ? lattice.withUnitMonomers() : lattice.reducedMonomers();
+        knownSolutions = LatticeReduction::trivialSolutions(monomers);
+    } else if (mode == 1) {
+        monomers = HelperMethods::add_unit_monomers(monomers);
+    }
+    std::vector<int> searchOrder = BranchOrder::order(monomers, branch_order);
+    monomers = BranchOrder::apply(monomers, searchOrder);
+    knownSolutions = BranchOrder::reorder(knownSolutions, searchOrder);
+
+    HilbertBasis hb(monomers);
+    hb.verbose = false;
+    return CostEstimator::estimate(hb, knownSolutions, estimate_levels, estimate_warmup_probes, estimate_probes, seed);
+}
+
+// Search cost estimator: predicts the node count and runtime of project2 on
+// the full system, or on each block of monomers and their sum
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <input_file> [<blocks_file>]" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::vector<int>> monomers;
+    std::vector<std::vector<int>> blocks;
+    try {
+        monomers = HelperMethods::parseMonomersFile(argv[1]);
+        if (argc >= 3) {
+            blocks = HelperMethods::parseBlocksFile(argv[2], monomers.size());
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    CostEstimate total;
+    try {
+        if (blocks.empty()) {
+            total = estimateSystem(monomers, estimate_seed);
+        } else {
+            std::vector<CostEstimate> estimates;
+            for (size_t b = 0; b < blocks.size(); b++) {
+                std::vector<std::vector<int>> subset;
+                for (int i : blocks[b]) {
+                    subset.push_back(monomers[i]);
+                }
+                estimates.push_back(estimateSystem(subset, estimate_seed + b));
+                std::cout << "Block " << b + 1 << ": " << estimates.back().nodes << " nodes, "
+                          << estimates.back().seconds << " s" << std::endl;
+            }
+            total = CostEstimator::combine(estimates);
+            std::cout << "\nTotal over " << blocks.size() << " blocks:" << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    CostEstimator::printEstimate(total);
+
+    auto end = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+    std::cout << "\nExecution time: " << duration.count() << " microseconds";
+    std::cout << " (" << duration.count() / 1000.0 << " milliseconds)" << std::endl;
+
+    return 0;
+}
@@ -5,12 +5,14 @@ import os
 import sys
 import argparse
 import itertools
+import re
 from collections import OrderedDict
 from unittest import result
 import requests
 from bs4 import BeautifulSoup
 import threading
 from export_polymers import save_polymer_vectors
+from monomers_to_normaliz import create_vector_representation
 import numpy as np
 
 # Config
@@ -18,16 +20,23 @@ import numpy as np
 monomer_file = "/Users/archit/Projects/Hilbert Basis Algorithm/example-tbns/cascade_n10.txt"
 python_script = "monomers_to_normaliz.py"
 normaliz_exe = "/Users/archit/Projects/Hilbert Basis Algorithm/my_testing/Normaliz/source/normaliz"
+# Native search cost estimator, built from backup/project6.cxx (used by --estimate)
+estimator_exe = "/Users/archit/Projects/Hilbert Basis Algorithm/my_testing/backup/project6"
 
 save = True
 save_dir = "/Users/archit/Projects/Hilbert Basis Algorithm/my_testing/pareto_optimal_set_cascade10"
 os.makedirs(save_dir, exist_ok=True)
+# Precomputed covering designs for the 57-monomer system at t=5
+local_covering_dir = "/Users/archit/Projects/Hilbert Basis Algorithm/my_testing/pareto_optimal_set_cascade8"
 
 
 tmp_monomers = "tmp_monomers.txt"
 tmp_eqs = "eqs.in"
 
 PROBE_LIMIT = 100
+ESTIMATE_SAMPLE = 10  # covering blocks per k handed to the native estimator
+tmp_estimate_monomers = "estimate_monomers.txt"
+tmp_estimate_blocks = "estimate_blocks.txt"
 
 """
 FLAGS
@@ -79,6 +88,15 @@ FLAGS
     Must be >= 1.0. E.g. --tolerance 1.2 allows up to 20% slack before
     pruning, which helps avoid premature pruning due to random timing spikes.
 
+--estimate  [covering strategy only]
+    Before the sweep, rank every k with the native cost estimator
+    (estimator_exe). For ESTIMATE_SAMPLE blocks of each covering design it runs
+    the first levels of the search and samples random paths below them, which
+    takes seconds per k. The sweep then visits k from the cheapest predicted
+    total upwards. It still probes each k with up to PROBE_LIMIT Normaliz runs,
+    but probe-and-prune now cuts the expensive values early. The estimates are for the native engine,
+    not Normaliz, so only their order is used.
+
 Interactive (during run)
 ------------------------
 s   Skip the current k value (covering) or abort the naive run immediately.
@@ -317,6 +335,97 @@ def load_covering_blocks(v: int, k: int, t: int, fallback_greedy: bool = False):
         yield block
 
 
+def load_monomer_covering_blocks(v: int, k: int, t: int, fallback_greedy: bool = False) -> list[list[int]]:
+    """Covering blocks over monomers. The C(57,k,5) designs are read from local_covering_dir."""
+    if v == 57 and t == 5 and k != 57:
+        return list(fetch_covering_local(v, k, t, base_dir=local_covering_dir))
+    return list(load_covering_blocks(v, k, t, fallback_greedy=fallback_greedy))
+
+
+# -------------------------
+# Native cost estimates (--estimate)
+# -------------------------
+
+def write_estimator_monomers(all_monomers: list[str], path: str):
+    """Numeric monomer file for the native engine, one row of site counts per monomer."""
+    domain_order = get_all_unique_domains(all_monomers)
+    with open(path, "w") as f:
+        for m in all_monomers:
+            f.write(" ".join(map(str, create_vector_representation(m, domain_order))) + "\n")
+
+
+def block_monomer_indices(block, mode, all_monomers, all_domains) -> list[int]:
+    """1-based indices of the monomers a covering block selects."""
+    if mode == "monomer":
+        return list(block)
+    selected_set = {all_domains[i - 1] for i in block}
+    return [i + 1 for i, m in enumerate(all_monomers)
+            if get_domains_from_monomer(m).issubset(selected_set)]
+
+
+def estimate_blocks(blocks: list[list[int]]):
+    """Predicted seconds of the native search summed over blocks, with the low and high ends of the
+    estimator's sampling spread (which is not a bound on the real time)."""
+    with open(tmp_estimate_blocks, "w") as f:
+        for block in blocks:
+            f.write(" ".join(map(str, block)) + "\n")
+    out = subprocess.run([estimator_exe, tmp_estimate_monomers, tmp_estimate_blocks],
+                         capture_output=True, text=True, check=True).stdout
+    match = re.search(r"Estimated seconds: (\S+) \(sampling spread (\S+) - (\S+)\)", out)
+    if match is None:
+        raise RuntimeError("estimator printed no estimate")
+    return tuple(float(x) for x in match.groups())
+
+
+def rank_k_values(k_values, args, all_monomers, all_domains, n, log) -> list[int]:
+    """
+    Order k_values by the estimated total time of their covering designs,
+    extrapolated from ESTIMATE_SAMPLE evenly spaced blocks. Values that could
+    not be estimated keep their order at the end.
+    """
+    write_estimator_monomers(all_monomers, tmp_estimate_monomers)
+    ranked = []
+    for k in k_values:
+        try:
+            if args.mode == "monomer":
+                blocks = load_monomer_covering_blocks(n, k, args.t, fallback_greedy=args.fallback_greedy)
+            else:
+                blocks = list(load_covering_blocks(n, k, args.t, fallback_greedy=args.fallback_greedy))
+        except (RuntimeError, requests.RequestException) as e:
+            print(f"Not estimating k={k}: {e}")
+            continue
+
+        step = max(1, len(blocks) // ESTIMATE_SAMPLE)
+        sample = [block_monomer_indices(b, args.mode, all_monomers, all_domains)
+                  for b in blocks[::step][:ESTIMATE_SAMPLE]]
+        sample = [b for b in sample if b]
+        if not sample:
+            continue
+        try:
+            seconds, low, high = estimate_blocks(sample)
+        except (subprocess.CalledProcessError, RuntimeError) as e:
+            print(f"Not estimating k={k}: {e}")
+            continue
+        scale = len(blocks) / len(sample)
+        ranked.append((seconds * scale, low * scale, high * scale, k, len(blocks)))
+
+    ranked.sort()
+    print(f"\nEstimated native search time per k ({ESTIMATE_SAMPLE} blocks sampled each):")
+    log.write("\nEstimated native search time per k:\n")
+    for seconds, low, high, k, num_blocks in ranked:
+        line = f"  k={k}: {seconds:.2f}s (sampling spread {low:.2f}-{high:.2f}s) over {num_blocks} blocks"
+        print(line)
+        log.write(line + "\n")
+    log.flush()
+
+    for path in (tmp_estimate_monomers, tmp_estimate_blocks):
+        if os.path.exists(path):
+            os.remove(path)
+
+    ordered = [k for _, _, _, k, _ in ranked]
+    return ordered + [k for k in k_values if k not in ordered]
+
+
 # -------------------------
 # Core pipeline: MONOMER MODE
 # -------------------------
@@ -331,10 +440,7 @@ def run_for_k_value_monomer(k, all_monomers, n, t, min_total_time, log, fallback
     print(f"{'='*70}\n")
 
     try:
-        if n == 57 and t == 5 and k != 57:
-            blocks = list(fetch_covering_local(n, k, t, base_dir="/Users/archit/Projects/Hilbert Basis Algorithm/my_testing/pareto_optimal_set_cascade8"))
-        else:
-            blocks = list(load_covering_blocks(n, k, t, fallback_greedy=fallback_greedy))
+        blocks = load_monomer_covering_blocks(n, k, t, fallback_greedy=fallback_greedy)
     except (RuntimeError, requests.RequestException) as e:
         print(f"Skipping k={k}: {e}")
         log.write(f"\nk={k}: SKIPPED (covering unavailable: {e})\n")
@@ -694,6 +800,10 @@ def validate_args(args, n_monomers, n_domains):
                 f"--fallback-greedy has no effect in naive mode (no covering\n"
                 f"  design is fetched or computed)."
             )
+        if args.estimate:
+            warnings.append(
+                f"--estimate has no effect in naive mode (there is a single k)."
+            )
 
     else:  # covering strategy
         # --t
@@ -848,6 +958,17 @@ def main():
             "share the same domain types (e.g. cascade or binary-tree TBNs)."
         )
     )
+    parser.add_argument(
+        "--estimate",
+        action="store_true",
+        help=(
+            "Rank the k values with the native cost estimator before the sweep "
+            "and sweep them from the cheapest predicted total upwards. Ranking "
+            "takes seconds per k; the sweep still probes each k with up to "
+            "PROBE_LIMIT Normaliz runs, but the ranking lets pruning cut the "
+            "expensive values early."
+        )
+    )
     parser.add_argument(
         "--tolerance",
         type=float,
@@ -986,6 +1107,10 @@ def main():
             + "=" * 70 + "\n"
         )
 
+        if args.estimate:
+            k_values = rank_k_values(k_values, args, all_monomers, all_domains, n_for_covering, log)
+            print(f"Sweeping k in estimated order: {k_values}\n")
+
         try:
             for k in k_values:
                 if args.mode == "monomer":